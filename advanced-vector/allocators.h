@@ -0,0 +1,452 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Арена: выделяет память последовательно из заранее выделенного блока.
+// Освобождение отдельных блоков не поддерживается, вся память
+// возвращается разом вызовом Reset или в деструкторе
+class ArenaResource {
+public:
+    explicit ArenaResource(size_t bytes)
+        : begin_(static_cast<char*>(operator new(bytes)))
+        , cursor_(begin_)
+        , end_(begin_+bytes) {
+    }
+
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+
+    ~ArenaResource() {
+        operator delete(begin_);
+    }
+
+    // Выделяет bytes байт с выравниванием align.
+    // При нехватке места в арене память берётся из кучи
+    void* Allocate(size_t bytes, size_t align) {
+        uintptr_t ptr = reinterpret_cast<uintptr_t>(cursor_);
+        uintptr_t aligned = (ptr+align-1) & ~(align-1);
+        if (aligned+bytes <= reinterpret_cast<uintptr_t>(end_)) {
+            cursor_ = reinterpret_cast<char*>(aligned+bytes);
+            return reinterpret_cast<void*>(aligned);
+        }
+        return operator new(bytes, std::align_val_t{align});
+    }
+
+    // Освобождает блок, если он был выделен из кучи.
+    // Память самой арены освобождается только через Reset
+    void Deallocate(void* ptr, size_t align) noexcept {
+        if (ptr < begin_ || ptr >= end_) {
+            operator delete(ptr, std::align_val_t{align});
+        }
+    }
+
+    // Сбрасывает арену, делая всю её память снова доступной
+    void Reset() noexcept {
+        cursor_ = begin_;
+    }
+
+    // Возвращает число занятых байт арены
+    size_t Used() const noexcept {
+        return cursor_-begin_;
+    }
+
+private:
+    char* begin_ = nullptr;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+};
+
+// Аллокатор поверх арены, пригодный для RawMemory/Vector:
+// Vector<T, ArenaAllocator<T>> v{ArenaAllocator<T>{arena}};
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(ArenaResource& arena) noexcept
+        : arena_(&arena) {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena_(&other.GetArena()) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t /*n*/) noexcept {
+        arena_->Deallocate(ptr, alignof(T));
+    }
+
+    // Возвращает арену, из которой выделяется память
+    ArenaResource& GetArena() const noexcept {
+        return *arena_;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& rhs) const noexcept {
+        return arena_ == &rhs.GetArena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    ArenaResource* arena_ = nullptr;
+};
+
+// Аллокатор с гарантированным выравниванием каждого блока по Align
+// байт — под SIMD-ядра, требующие выровненных загрузок
+// (например Vector<float, AlignedAllocator<float, 64>> для AVX-512).
+// Обычное переопределение выравнивания типа (alignas) RawMemory
+// учитывает и так: std::allocator выделяет с align_val_t
+template <typename T, size_t Align>
+class AlignedAllocator {
+    static_assert((Align & (Align-1)) == 0, "Выравнивание должно быть степенью двойки");
+    static_assert(Align >= alignof(T), "Выравнивание не может быть меньше естественного");
+
+public:
+    using value_type = T;
+
+    // Перепривязка обязана сохранять выравнивание в байтах
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T* ptr, size_t /*n*/) noexcept {
+        operator delete(ptr, std::align_val_t{Align});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const noexcept {
+        return false;
+    }
+};
+
+#if defined(__linux__) && defined(__NR_mbind)
+
+// Режим размещения страниц по NUMA-узлам
+enum class NumaPlacement {
+    FirstTouch,   // страница ложится на узел потока, который первым её тронул
+    BindToNode,   // все страницы привязываются к заданному узлу
+    Interleave,   // страницы чередуются по всем узлам
+};
+
+// Аллокатор с контролем NUMA-размещения: выделяет страницы mmap
+// и задаёт политику их раскладки через mbind. Режим FirstTouch
+// не вызывает mbind вовсе — в паре с Vector::ResizeParallel страницы
+// фолтятся на узлах потоков-потребителей. Неудача mbind (например,
+// одноузловая машина) не считается ошибкой: память остаётся
+// пригодной, теряется только размещение
+template <typename T>
+class NumaAllocator {
+public:
+    using value_type = T;
+
+    // По умолчанию — first-touch
+    NumaAllocator() = default;
+
+    // Возвращает аллокатор, привязывающий страницы к узлу node
+    static NumaAllocator BindToNode(int node) noexcept {
+        NumaAllocator alloc;
+        alloc.placement_ = NumaPlacement::BindToNode;
+        alloc.node_ = node;
+        return alloc;
+    }
+
+    // Возвращает аллокатор, чередующий страницы по узлам nodemask
+    static NumaAllocator Interleave(unsigned long nodemask = DetectNodeMask()) noexcept {
+        NumaAllocator alloc;
+        alloc.placement_ = NumaPlacement::Interleave;
+        alloc.nodemask_ = nodemask;
+        return alloc;
+    }
+
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept
+        : placement_(other.GetPlacement())
+        , node_(other.GetNode())
+        , nodemask_(other.GetNodeMask()) {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        void* ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        ApplyPlacement(ptr, bytes);
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        ::munmap(ptr, n * sizeof(T));
+    }
+
+    NumaPlacement GetPlacement() const noexcept {
+        return placement_;
+    }
+
+    int GetNode() const noexcept {
+        return node_;
+    }
+
+    unsigned long GetNodeMask() const noexcept {
+        return nodemask_;
+    }
+
+    template <typename U>
+    bool operator==(const NumaAllocator<U>& rhs) const noexcept {
+        return placement_ == rhs.GetPlacement() &&
+               node_ == rhs.GetNode() &&
+               nodemask_ == rhs.GetNodeMask();
+    }
+
+    template <typename U>
+    bool operator!=(const NumaAllocator<U>& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    // Номера политик из <numaif.h>; объявлены локально, чтобы
+    // не тянуть зависимость от libnuma
+    static constexpr int MPOL_BIND_ = 2;
+    static constexpr int MPOL_INTERLEAVE_ = 3;
+
+    // Определяет маску существующих узлов по sysfs
+    static unsigned long DetectNodeMask() noexcept {
+        unsigned long mask = 0;
+        for (int node = 0; node < 64; ++node) {
+            char path[64];
+            std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", node);
+            if (::access(path, F_OK) != 0) {
+                break;
+            }
+            mask |= 1ul << node;
+        }
+        return mask != 0 ? mask : 1ul;
+    }
+
+    void ApplyPlacement(void* ptr, size_t bytes) const noexcept {
+        if (placement_ == NumaPlacement::FirstTouch) {
+            return;
+        }
+        const int mode = placement_ == NumaPlacement::BindToNode ? MPOL_BIND_ : MPOL_INTERLEAVE_;
+        const unsigned long mask = placement_ == NumaPlacement::BindToNode
+            ? 1ul << node_
+            : nodemask_;
+        // Результат сознательно игнорируется: на одноузловой машине
+        // или без прав mbind просто не меняет размещение
+        ::syscall(__NR_mbind, ptr, bytes, mode, &mask, sizeof(mask) * 8, 0ul);
+    }
+
+    NumaPlacement placement_ = NumaPlacement::FirstTouch;
+    int node_ = 0;
+    unsigned long nodemask_ = 1;
+};
+
+#endif  // __linux__ && __NR_mbind
+
+#ifdef __linux__
+
+// Аллокатор с поддержкой крупных страниц: блоки от Threshold байт
+// выделяются mmap с MAP_HUGETLB, а если зарезервированных крупных
+// страниц в системе нет — обычным mmap с madvise(MADV_HUGEPAGE),
+// отдавая ядру прозрачное склеивание. Мелкие блоки идут через
+// глобальную кучу. В паре с политикой роста GrowthHugePage шаги
+// вместимости кратны крупной странице и реаллокация не дробит
+// отображение
+template <typename T, size_t Threshold = 2 * 1024 * 1024>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    // Перепривязка обязана сохранять порог в байтах
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U, Threshold>;
+    };
+
+    HugePageAllocator() = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U, Threshold>&) noexcept {
+    }
+
+    // noinline обрывает межпроцедурный анализ GCC, который иначе
+    // "спаривает" мелкое выделение одной итерации роста с обращением
+    // следующей и даёт ложный -Warray-bounds
+    __attribute__((noinline)) T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        if (bytes < Threshold) {
+            return static_cast<T*>(operator new(bytes));
+        }
+        const size_t rounded = RoundToHugePage(bytes);
+        void* ptr = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED) {
+            // Крупные страницы не зарезервированы — обычные страницы
+            // плюс подсказка ядру склеить их в прозрачные крупные
+            ptr = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) {
+                throw std::bad_alloc{};
+            }
+#ifdef MADV_HUGEPAGE
+            ::madvise(ptr, rounded, MADV_HUGEPAGE);
+#endif
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (bytes < Threshold) {
+            operator delete(ptr);
+            return;
+        }
+        ::munmap(ptr, RoundToHugePage(bytes));
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U, Threshold>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U, Threshold>&) const noexcept {
+        return false;
+    }
+
+private:
+    static constexpr size_t HUGE_PAGE_BYTES = 2 * 1024 * 1024;
+
+    static size_t RoundToHugePage(size_t bytes) noexcept {
+        return (bytes+HUGE_PAGE_BYTES-1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+    }
+};
+
+#endif  // __linux__
+
+// Аллокатор с потоколокальными списками свободных блоков.
+// Блоки округляются до степени двойки и после deallocate
+// переиспользуются без обращения к глобальной куче
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = RoundUp(n * sizeof(T));
+        const size_t index = ClassIndex(bytes);
+        if (index < NUM_CLASSES) {
+            FreeBlock*& head = FreeLists()[index];
+            if (head != nullptr) {
+                return reinterpret_cast<T*>(std::exchange(head, head->next));
+            }
+        }
+        return static_cast<T*>(operator new(bytes));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        const size_t bytes = RoundUp(n * sizeof(T));
+        const size_t index = ClassIndex(bytes);
+        if (index < NUM_CLASSES) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(ptr);
+            FreeBlock*& head = FreeLists()[index];
+            block->next = head;
+            head = block;
+            return;
+        }
+        operator delete(ptr);
+    }
+
+    // Возвращает в глобальную кучу все блоки, накопленные текущим потоком
+    static void TrimThreadCache() noexcept {
+        for (size_t i = 0; i < NUM_CLASSES; ++i) {
+            FreeBlock* head = std::exchange(FreeLists()[i], nullptr);
+            while (head != nullptr) {
+                operator delete(std::exchange(head, head->next));
+            }
+        }
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept {
+        return false;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Классы размеров: 2^4 .. 2^20 байт, более крупные блоки идут мимо пула
+    static constexpr size_t MIN_SHIFT = 4;
+    static constexpr size_t MAX_SHIFT = 20;
+    static constexpr size_t NUM_CLASSES = MAX_SHIFT-MIN_SHIFT+1;
+
+    // Округляет bytes вверх до степени двойки, но не меньше минимального класса
+    static size_t RoundUp(size_t bytes) noexcept {
+        size_t result = size_t{1} << MIN_SHIFT;
+        while (result < bytes) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    static size_t ClassIndex(size_t bytes) noexcept {
+        size_t shift = MIN_SHIFT;
+        while ((size_t{1} << shift) < bytes) {
+            ++shift;
+        }
+        return shift-MIN_SHIFT;
+    }
+
+    static FreeBlock** FreeLists() noexcept {
+        static thread_local FreeBlock* lists[NUM_CLASSES] = {};
+        return lists;
+    }
+};
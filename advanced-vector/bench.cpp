@@ -0,0 +1,165 @@
+#include "vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// Счётчики глобальных выделений памяти — видны из operator new,
+// чтобы отчитываться не только временем, но и байтами
+namespace {
+
+size_t g_allocations = 0;
+size_t g_bytes_allocated = 0;
+
+void ResetAllocCounters() {
+    g_allocations = 0;
+    g_bytes_allocated = 0;
+}
+
+}  // namespace
+
+// noinline не даёт оптимизатору "спарить" malloc/free с чужими
+// точками выделения и выдать ложный -Wmismatched-new-delete
+__attribute__((noinline)) void* operator new(size_t bytes) {
+    ++g_allocations;
+    g_bytes_allocated += bytes;
+    if (void* ptr = std::malloc(bytes)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t /*bytes*/) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+// Нетривиальный тип с noexcept-перемещением: реаллокация перемещает
+struct MovableObj {
+    MovableObj() = default;
+    explicit MovableObj(int id) : id(id) {}
+    MovableObj(const MovableObj&) = default;
+    MovableObj(MovableObj&&) noexcept = default;
+    MovableObj& operator=(const MovableObj&) = default;
+    MovableObj& operator=(MovableObj&&) noexcept = default;
+
+    int id = 0;
+    std::string name = "some not so short string";
+};
+
+// Перемещающий конструктор не noexcept: реаллокация копирует
+struct CopyOnlyObj {
+    CopyOnlyObj() = default;
+    explicit CopyOnlyObj(int id) : id(id) {}
+    CopyOnlyObj(const CopyOnlyObj&) = default;
+    CopyOnlyObj(CopyOnlyObj&& other) : id(other.id), name(std::move(other.name)) {}
+
+    int id = 0;
+    std::string name = "some not so short string";
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Запускает fn, печатает ns/op на ops операций и статистику выделений
+template <typename Fn>
+void RunCase(const char* name, size_t ops, Fn fn) {
+    ResetAllocCounters();
+    const auto start = Clock::now();
+    fn();
+    const auto finish = Clock::now();
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(finish-start).count();
+    std::printf("%-34s %10.1f ns/op %10zu allocs %12zu bytes\n",
+                name, static_cast<double>(ns) / ops, g_allocations, g_bytes_allocated);
+}
+
+// Рост через PushBack с нуля: кривая удвоения вместимости
+template <typename T>
+void BenchPushBackGrowth(const char* name, size_t count) {
+    RunCase(name, count, [count] {
+        Vector<T> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.PushBack(T(static_cast<int>(i)));
+        }
+    });
+}
+
+// Reserve заранее против наивного роста
+void BenchReserveVsGrowth(size_t count) {
+    RunCase("int: naive growth", count, [count] {
+        Vector<int> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+    });
+    RunCase("int: Reserve+fill", count, [count] {
+        Vector<int> v;
+        v.Reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+    });
+}
+
+// Вставка и удаление в середине вектора
+template <typename T>
+void BenchInsertErase(const char* name, size_t size, size_t ops) {
+    RunCase(name, ops, [size, ops] {
+        Vector<T> v;
+        v.Reserve(size+ops);
+        for (size_t i = 0; i < size; ++i) {
+            v.PushBack(T(static_cast<int>(i)));
+        }
+        for (size_t i = 0; i < ops; ++i) {
+            v.Insert(v.cbegin()+size / 2, T(-1));
+        }
+        for (size_t i = 0; i < ops; ++i) {
+            v.Erase(v.cbegin()+size / 2);
+        }
+    });
+}
+
+// Реаллокация перемещением против копирования
+void BenchRelocation(size_t count) {
+    {
+        Vector<MovableObj> v(count);
+        RunCase("move relocation (Reserve x2)", count, [&v, count] {
+            v.Reserve(count * 2);
+        });
+    }
+    {
+        Vector<CopyOnlyObj> v(count);
+        RunCase("copy relocation (Reserve x2)", count, [&v, count] {
+            v.Reserve(count * 2);
+        });
+    }
+}
+
+}  // namespace
+
+int main() {
+    const size_t GROW_COUNT = 1'000'000;
+    const size_t MID_SIZE = 10'000;
+    const size_t MID_OPS = 2'000;
+
+    std::printf("--- PushBack growth ---\n");
+    BenchPushBackGrowth<int>("int: PushBack growth", GROW_COUNT);
+    BenchPushBackGrowth<MovableObj>("MovableObj: PushBack growth", GROW_COUNT / 10);
+
+    std::printf("--- Reserve vs naive growth ---\n");
+    BenchReserveVsGrowth(GROW_COUNT);
+
+    std::printf("--- mid-vector Insert/Erase ---\n");
+    BenchInsertErase<int>("int: Insert+Erase middle", MID_SIZE, MID_OPS);
+    BenchInsertErase<MovableObj>("MovableObj: Insert+Erase middle", MID_SIZE, MID_OPS);
+
+    std::printf("--- relocation: move vs copy ---\n");
+    BenchRelocation(GROW_COUNT / 10);
+    return 0;
+}
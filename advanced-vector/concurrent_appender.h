@@ -0,0 +1,54 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// Фасад ограниченной многопоточной дозаписи в заранее
+// зарезервированный Vector. Продюсеры занимают слоты одним
+// атомарным fetch_add и конструируют элементы на месте, без
+// блокировок, шардирования и слияния. Рост вместимости не
+// поддерживается: вектор обязан быть Reserve-нут заранее,
+// а Finalize публикует итоговый размер после остановки продюсеров
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = GrowthX2>
+class ConcurrentAppender {
+public:
+    explicit ConcurrentAppender(Vector<T, Alloc, Growth>& target) noexcept
+        : target_(target)
+        , cursor_(target.Size()) {
+    }
+
+    ConcurrentAppender(const ConcurrentAppender&) = delete;
+    ConcurrentAppender& operator=(const ConcurrentAppender&) = delete;
+
+    // Занимает слот и конструирует в нём элемент. Возвращает false,
+    // если зарезервированная вместимость исчерпана.
+    // Можно звать из любого числа потоков одновременно
+    template <typename... Args>
+    bool TryEmplaceBack(Args&&... args) {
+        const size_t index = cursor_.fetch_add(1, std::memory_order_relaxed);
+        if (index >= target_.Capacity()) {
+            // Слот за пределами вместимости: курсор не откатываем,
+            // Finalize обрежет его по вместимости
+            return false;
+        }
+        std::construct_at(target_.begin()+index, std::forward<Args>(args)...);
+        return true;
+    }
+
+    // Возвращает количество успешно занятых слотов
+    size_t Size() const noexcept {
+        const size_t claimed = cursor_.load(std::memory_order_acquire);
+        const size_t capacity = target_.Capacity();
+        return claimed < capacity ? claimed : capacity;
+    }
+
+    // Публикует итоговый размер вектора. Вызывается одним потоком,
+    // когда все продюсеры закончили дозапись
+    void Finalize() noexcept {
+        target_.SetSizeUnchecked(Size());
+    }
+
+private:
+    Vector<T, Alloc, Growth>& target_;
+    std::atomic<size_t> cursor_;
+};
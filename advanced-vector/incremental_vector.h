@@ -0,0 +1,217 @@
+#pragma once
+#include "vector.h"
+
+// Вектор с инкрементальной реаллокацией: новый буфер выделяется
+// заранее, при пересечении ватермарки заполнения (90% вместимости),
+// а перенос элементов размазывается по последующим операциям кусками
+// не больше MigrationChunk — вместо одного синхронного переезда,
+// который на стомиллионном векторе блокирует цикл обработки на сотни
+// миллисекунд. Дозаписи во время миграции идут сразу в новый буфер.
+// Требует типа, переносимого без исключений: прерванная исключением
+// миграция не откатывается
+template <typename T, size_t MigrationChunk = 1024, typename Alloc = std::allocator<T>>
+class IncrementalVector {
+    static_assert(IsTriviallyRelocatable<T>::value ||
+                  std::is_nothrow_move_constructible_v<T> ||
+                  AssumeNothrowMove<T>::value,
+                  "Инкрементальная миграция требует не бросающего переноса");
+    static_assert(MigrationChunk > 0, "Кусок миграции должен быть больше нуля");
+
+public:
+    IncrementalVector() = default;
+
+    IncrementalVector(const IncrementalVector&) = delete;
+    IncrementalVector& operator=(const IncrementalVector&) = delete;
+
+    IncrementalVector(IncrementalVector&& other) noexcept
+        : storage_(std::move(other.storage_))
+        , next_(std::move(other.next_))
+        , migrate_pos_(std::exchange(other.migrate_pos_, 0))
+        , migrating_(std::exchange(other.migrating_, false))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    IncrementalVector& operator=(IncrementalVector&& rhs) noexcept {
+        if (this != &rhs) {
+            DestroyAll();
+            storage_ = std::move(rhs.storage_);
+            next_ = std::move(rhs.next_);
+            migrate_pos_ = std::exchange(rhs.migrate_pos_, 0);
+            migrating_ = std::exchange(rhs.migrating_, false);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    ~IncrementalVector() {
+        DestroyAll();
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Возвращает текущую вместимость (нового буфера, если идёт миграция)
+    size_t Capacity() const noexcept {
+        return migrating_ ? next_.Capacity() : storage_.Capacity();
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return (0 == size_);
+    }
+
+    // Сообщает, идёт ли фоновая миграция в новый буфер
+    bool IsMigrating() const noexcept {
+        return migrating_;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    T& operator[](size_t index) noexcept {
+        ADVANCED_VECTOR_VERIFY(index < size_);
+        return Locate(index)[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<IncrementalVector&>(*this)[index];
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    // Перемещает элемент в конец вектора
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Конструирует элемент в конце вектора. Работа по переносу
+    // ограничена одним куском MigrationChunk за вызов
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (!migrating_ && NeedsGrowth()) {
+            StartMigration();
+        }
+        T* entry;
+        if (migrating_) {
+            entry = std::construct_at(next_+size_, std::forward<Args>(args)...);
+            ++size_;
+            MigrateChunk();
+        }
+        else {
+            entry = std::construct_at(storage_+size_, std::forward<Args>(args)...);
+            ++size_;
+        }
+        return *entry;
+    }
+
+    // "Удаляет" последний элемент вектора
+    void PopBack() noexcept {
+        if (size_ == 0) {
+            return;
+        }
+        --size_;
+        DestroyN(Locate(size_)+size_, 1);
+        if (migrating_) {
+            // Опустившийся ниже границы миграции хвост уже разрушен —
+            // переносить его не нужно
+            if (size_ < migrate_pos_) {
+                migrate_pos_ = size_;
+            }
+            MigrateChunk();
+        }
+    }
+
+    // Заранее запускает миграцию в буфер вместимости не меньше
+    // new_capacity. Если запрошено больше, чем цель уже идущей
+    // миграции, та доводится до конца и стартует новая — после
+    // вызова Capacity() гарантированно не меньше new_capacity
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        CompleteMigration();
+        StartMigration(new_capacity);
+    }
+
+    // Доводит миграцию до конца; после вызова элементы снова
+    // лежат одним непрерывным массивом
+    void CompleteMigration() noexcept {
+        while (migrating_) {
+            MigrateChunk();
+        }
+    }
+
+    // Возвращает указатель на непрерывные данные,
+    // предварительно завершив миграцию
+    T* Data() noexcept {
+        CompleteMigration();
+        return storage_.GetAddress();
+    }
+
+    T* begin() noexcept {
+        return Data();
+    }
+
+    T* end() noexcept {
+        return Data()+size_;
+    }
+
+private:
+    // Миграция стартует на 90% заполнения, чтобы переезд успел
+    // размазаться по оставшимся дозаписям
+    bool NeedsGrowth() const noexcept {
+        const size_t capacity = storage_.Capacity();
+        return size_+1 > capacity-capacity / 10;
+    }
+
+    void StartMigration(size_t min_capacity = 0) {
+        const size_t doubled = storage_.Capacity() == 0 ? 1 : storage_.Capacity() * 2;
+        next_ = RawMemory<T, Alloc>(doubled < min_capacity ? min_capacity : doubled,
+                                    storage_.GetAllocator());
+        migrate_pos_ = size_;
+        migrating_ = true;
+    }
+
+    // Переносит очередной кусок со старшего конца старого буфера
+    void MigrateChunk() noexcept {
+        size_t budget = MigrationChunk < migrate_pos_ ? MigrationChunk : migrate_pos_;
+        while (budget-- > 0) {
+            --migrate_pos_;
+            RelocateN(storage_+migrate_pos_, 1, next_+migrate_pos_);
+        }
+        if (migrate_pos_ == 0) {
+            storage_ = std::move(next_);
+            next_ = RawMemory<T, Alloc>{};
+            migrating_ = false;
+        }
+    }
+
+    // Возвращает буфер, в котором живёт элемент с индексом index
+    RawMemory<T, Alloc>& Locate(size_t index) noexcept {
+        return migrating_ && index >= migrate_pos_ ? next_ : storage_;
+    }
+
+    void DestroyAll() noexcept {
+        if (migrating_) {
+            DestroyN(storage_.GetAddress(), migrate_pos_);
+            if (size_ > migrate_pos_) {
+                DestroyN(next_+migrate_pos_, size_-migrate_pos_);
+            }
+        }
+        else {
+            DestroyN(storage_.GetAddress(), size_);
+        }
+        migrating_ = false;
+        migrate_pos_ = 0;
+        size_ = 0;
+    }
+
+    RawMemory<T, Alloc> storage_;
+    RawMemory<T, Alloc> next_;
+    size_t migrate_pos_ = 0;
+    bool migrating_ = false;
+    size_t size_ = 0;
+};
@@ -0,0 +1,219 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Вектор, хранящий элементы в отображённом в память файле.
+// Данные страничного кэша подгружаются по обращению, а после
+// перезапуска процесс продолжает работу с уже заполненным файлом
+// без повторной загрузки. Доступен только для тривиально
+// копируемых типов: элементы живут на диске как сырые байты
+template <typename T>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "MappedVector работает только с тривиально копируемыми типами");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // Открывает (или создаёт) файл-хранилище по пути path
+    // с местом минимум под min_capacity элементов
+    explicit MappedVector(const std::string& path, size_t min_capacity = 1) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("MappedVector: не удалось открыть " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("MappedVector: fstat не удался для " + path);
+        }
+        const bool fresh = (st.st_size == 0);
+        size_t bytes = fresh
+            ? HEADER_BYTES+ToBytes(min_capacity < 1 ? 1 : min_capacity)
+            : static_cast<size_t>(st.st_size);
+        if (fresh && ::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("MappedVector: ftruncate не удался для " + path);
+        }
+        Map(bytes);
+        if (fresh) {
+            header_->magic = MAGIC;
+            header_->element_size = sizeof(T);
+            header_->size = 0;
+        }
+        else if (header_->magic != MAGIC || header_->element_size != sizeof(T)) {
+            Unmap();
+            ::close(fd_);
+            throw std::runtime_error("MappedVector: несовместимый формат файла " + path);
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , mapped_bytes_(std::exchange(other.mapped_bytes_, 0))
+        , header_(std::exchange(other.header_, nullptr))
+        , data_(std::exchange(other.data_, nullptr)) {
+    }
+
+    ~MappedVector() {
+        if (header_ != nullptr) {
+            Unmap();
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    // Возвращает итератор на начало вектора
+    iterator begin() noexcept {
+        return data_;
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    iterator end() noexcept {
+        return data_+Size();
+    }
+
+    const_iterator begin() const noexcept {
+        return data_;
+    }
+
+    const_iterator end() const noexcept {
+        return data_+Size();
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t Size() const noexcept {
+        return static_cast<size_t>(header_->size);
+    }
+
+    // Возвращает вместимость вектора
+    size_t Capacity() const noexcept {
+        return (mapped_bytes_-HEADER_BYTES) / sizeof(T);
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return Size() == 0;
+    }
+
+    // Резервирует место, расширяя файл и переотображая его
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        const size_t new_bytes = HEADER_BYTES+ToBytes(new_capacity);
+        if (::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            throw std::runtime_error("MappedVector: не удалось расширить файл");
+        }
+        void* remapped = ::mremap(header_, mapped_bytes_, new_bytes, MREMAP_MAYMOVE);
+        if (remapped == MAP_FAILED) {
+            throw std::runtime_error("MappedVector: mremap не удался");
+        }
+        header_ = static_cast<Header*>(remapped);
+        data_ = reinterpret_cast<T*>(static_cast<char*>(remapped)+HEADER_BYTES);
+        mapped_bytes_ = new_bytes;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<MappedVector&>(*this)[index];
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const T& value) {
+        if (Size() == Capacity()) {
+            Reserve(Capacity() * 2);
+        }
+        data_[Size()] = value;
+        ++header_->size;
+    }
+
+    // "Удаляет" последний элемент вектора
+    void PopBack() noexcept {
+        if (header_->size > 0) {
+            --header_->size;
+        }
+    }
+
+    // Изменяет размер вектора. Новые элементы заполнены нулями:
+    // страницы за прежним концом файла обнуляет ядро, а байты внутри
+    // уже расширенного файла, оставшиеся от удалённых элементов,
+    // зануляются явно
+    void Resize(size_t new_size) {
+        Reserve(new_size);
+        const size_t old_size = Size();
+        if (new_size > old_size) {
+            std::memset(data_+old_size, 0, ToBytes(new_size-old_size));
+        }
+        header_->size = new_size;
+    }
+
+    // Сбрасывает содержимое на диск
+    void Flush() {
+        if (::msync(header_, mapped_bytes_, MS_SYNC) != 0) {
+            throw std::runtime_error("MappedVector: msync не удался");
+        }
+    }
+
+private:
+    struct Header {
+        uint64_t magic;
+        uint64_t element_size;
+        uint64_t size;
+    };
+
+    // Заголовок занимает целую страницу, данные выровнены по ней же
+    static constexpr size_t HEADER_BYTES = 4096;
+    static constexpr uint64_t MAGIC = 0x544345564d'4441ull;  // "AD MVECT"
+
+    static size_t ToBytes(size_t elements) noexcept {
+        return elements * sizeof(T);
+    }
+
+    void Map(size_t bytes) {
+        void* mapped = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, fd_, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd_);
+            throw std::runtime_error("MappedVector: mmap не удался");
+        }
+        header_ = static_cast<Header*>(mapped);
+        data_ = reinterpret_cast<T*>(static_cast<char*>(mapped)+HEADER_BYTES);
+        mapped_bytes_ = bytes;
+    }
+
+    void Unmap() noexcept {
+        ::munmap(header_, mapped_bytes_);
+        header_ = nullptr;
+        data_ = nullptr;
+    }
+
+    int fd_ = -1;
+    size_t mapped_bytes_ = 0;
+    Header* header_ = nullptr;
+    T* data_ = nullptr;
+};
+
+#endif  // __linux__
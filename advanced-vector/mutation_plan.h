@@ -0,0 +1,196 @@
+#pragma once
+#include "vector.h"
+
+// Пакет изменений одного вектора: произвольный набор вставок,
+// удалений и дозаписей применяется за одно вычисление итогового
+// размера, не больше одного выделения памяти и один общий проход
+// переноса — вместо отдельной реаллокации и сдвига хвоста на каждую
+// операцию. Индексы вставок и удалений задаются по исходному
+// состоянию вектора
+template <typename T>
+class MutationPlan {
+public:
+    // Вставить значение перед элементом с индексом index
+    void Insert(size_t index, T value) {
+        inserts_.EmplaceBack(InsertOp{index, std::move(value)});
+    }
+
+    // Удалить элемент с индексом index
+    void Erase(size_t index) {
+        erases_.PushBack(index);
+    }
+
+    // Дописать значение в конец
+    void Append(T value) {
+        appends_.PushBack(std::move(value));
+    }
+
+    // Сообщает, пуст ли план
+    bool IsEmpty() const noexcept {
+        return inserts_.IsEmpty() && erases_.IsEmpty() && appends_.IsEmpty();
+    }
+
+    // Очищает план для повторного использования
+    void Clear() noexcept {
+        inserts_.Clear();
+        erases_.Clear();
+        appends_.Clear();
+    }
+
+    // Применяет план к вектору и очищает план.
+    // Вставленные и дописанные значения перемещаются в вектор
+    template <typename Alloc, typename Growth>
+    void Apply(Vector<T, Alloc, Growth>& target) {
+        if (IsEmpty()) {
+            return;
+        }
+        const size_t old_size = target.Size();
+        if (inserts_.IsEmpty() && erases_.IsEmpty()) {
+            // Только дозапись: строим на месте, без переноса
+            target.AppendRange(std::make_move_iterator(appends_.begin()),
+                               std::make_move_iterator(appends_.end()));
+            Clear();
+            return;
+        }
+
+        std::stable_sort(inserts_.begin(), inserts_.end(),
+                         [](const InsertOp& lhs, const InsertOp& rhs) {
+                             return lhs.index < rhs.index;
+                         });
+        std::sort(erases_.begin(), erases_.end());
+        assert(inserts_.IsEmpty() || inserts_[inserts_.Size()-1].index <= old_size);
+        assert(erases_.IsEmpty() || erases_[erases_.Size()-1] < old_size);
+
+        const size_t erased = CountUnique(erases_);
+        const size_t final_size = old_size-erased+inserts_.Size()+appends_.Size();
+
+        // Пока вместимости хватает, план применяется на месте —
+        // без выделения памяти и без переноса всего содержимого
+        if (final_size <= target.Capacity()) {
+            ApplyInPlace(target, old_size);
+            Clear();
+            return;
+        }
+
+        // Вместимости не хватает: единственное выделение, и источник,
+        // вставки и удаления сливаются в новый буфер одним проходом,
+        // дозаписи идут следом
+        Vector<T, Alloc, Growth> result(target.GetAllocator());
+        result.Reserve(final_size);
+        T* out = result.Data();
+        size_t write = 0;
+        size_t ins = 0;
+        size_t ers = 0;
+        for (size_t i = 0; i <= old_size; ++i) {
+            for (; ins < inserts_.Size() && inserts_[ins].index == i; ++ins) {
+                std::construct_at(out+write++, std::move(inserts_[ins].value));
+            }
+            if (i == old_size) {
+                break;
+            }
+            bool skip = false;
+            for (; ers < erases_.Size() && erases_[ers] == i; ++ers) {
+                skip = true;
+            }
+            if (!skip) {
+                std::construct_at(out+write++, std::move(target[i]));
+            }
+        }
+        for (size_t i = 0; i < appends_.Size(); ++i) {
+            std::construct_at(out+write++, std::move(appends_[i]));
+        }
+        assert(write == final_size);
+        result.SetSizeUnchecked(write);
+        // Старый буфер (с перемещёнными и удалёнными элементами)
+        // разрушается при выходе временного вектора из области видимости
+        target = std::move(result);
+        Clear();
+    }
+
+private:
+    struct InsertOp {
+        size_t index;
+        T value;
+    };
+
+    // Применяет план в существующем буфере: уплотнение влево выносит
+    // удаляемые элементы, обратное слияние расставляет вставки
+    // (каждый выживший элемент переносится не более двух раз),
+    // дозаписи конструируются в конце. Памяти не выделяется
+    template <typename Alloc, typename Growth>
+    void ApplyInPlace(Vector<T, Alloc, Growth>& target, size_t old_size) {
+        T* values = target.Data();
+        size_t size_now = old_size;
+        if (!erases_.IsEmpty()) {
+            size_t write = erases_[0];
+            size_t ers = 0;
+            for (size_t read = erases_[0]; read < old_size; ++read) {
+                if (ers < erases_.Size() && erases_[ers] == read) {
+                    while (ers < erases_.Size() && erases_[ers] == read) {
+                        ++ers;
+                    }
+                    continue;
+                }
+                values[write++] = std::move(values[read]);
+            }
+            DestroyN(values+write, old_size-write);
+            size_now = write;
+        }
+
+        // Индексы вставок пересчитываются с учётом выбывших элементов
+        {
+            size_t ers = 0;
+            size_t removed = 0;
+            for (size_t i = 0; i < inserts_.Size(); ++i) {
+                while (ers < erases_.Size() && erases_[ers] < inserts_[i].index) {
+                    if (ers == 0 || erases_[ers] != erases_[ers-1]) {
+                        ++removed;
+                    }
+                    ++ers;
+                }
+                inserts_[i].index -= removed;
+            }
+        }
+
+        // Обратное слияние вставок — по образцу
+        // SortedVector::InsertSortedBatch
+        if (!inserts_.IsEmpty()) {
+            size_t write = size_now+inserts_.Size();
+            size_t i = size_now;
+            size_t j = inserts_.Size();
+            while (j > 0) {
+                --write;
+                T* source = (i > 0 && inserts_[j-1].index <= i-1)
+                    ? &values[--i]
+                    : &inserts_[--j].value;
+                if (write >= size_now) {
+                    std::construct_at(values+write, std::move(*source));
+                }
+                else {
+                    values[write] = std::move(*source);
+                }
+            }
+            size_now += inserts_.Size();
+        }
+
+        for (size_t i = 0; i < appends_.Size(); ++i) {
+            std::construct_at(values+size_now+i, std::move(appends_[i]));
+        }
+        target.SetSizeUnchecked(size_now+appends_.Size());
+    }
+
+    // Возвращает число различных индексов в отсортированном векторе
+    static size_t CountUnique(const Vector<size_t>& sorted) noexcept {
+        size_t count = 0;
+        for (size_t i = 0; i < sorted.Size(); ++i) {
+            if (i == 0 || sorted[i] != sorted[i-1]) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    Vector<InsertOp> inserts_;
+    Vector<size_t> erases_;
+    Vector<T> appends_;
+};
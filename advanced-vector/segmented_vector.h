@@ -0,0 +1,278 @@
+#pragma once
+#include "vector.h"
+
+// Вектор с сегментированным хранилищем: элементы лежат в блоках
+// фиксированного размера, а рост добавляет новый блок, никогда не
+// перемещая уже построенные элементы. Ссылки и указатели на элементы
+// переживают любой рост, а паузы реаллокации исчезают ценой одного
+// дополнительного разыменования при доступе по индексу
+template <typename T, size_t BlockSize = 1024, typename Alloc = std::allocator<T>>
+class SegmentedVector {
+    static_assert(BlockSize > 0, "Размер блока должен быть больше нуля");
+
+public:
+    // Итератор произвольного доступа поверх таблицы блоков
+    template <bool IsConst>
+    class BasicIterator {
+        friend class SegmentedVector;
+
+        using Owner = std::conditional_t<IsConst, const SegmentedVector, SegmentedVector>;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+        }
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() = default;
+
+        // Неконстантный итератор неявно преобразуется в константный
+        BasicIterator(const BasicIterator<false>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_) {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &(*owner_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_+offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old(*this);
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator old(*this);
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_)-static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend auto operator<=>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <=> rhs.index_;
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    SegmentedVector() = default;
+
+    // Создаёт вектор из size элементов
+    explicit SegmentedVector(size_t size) {
+        Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            EmplaceBack();
+        }
+    }
+
+    // Конструктор копирования
+    SegmentedVector(const SegmentedVector& other) {
+        Reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) {
+            EmplaceBack(other[i]);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : blocks_(std::move(other.blocks_))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+    // Обменивает значение с другим вектором
+    void Swap(SegmentedVector& other) noexcept {
+        blocks_.Swap(other.blocks_);
+        std::swap(size_, other.size_);
+    }
+
+    // Возвращает итератор на начало вектора
+    iterator begin() noexcept {
+        return iterator{this, 0};
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    iterator end() noexcept {
+        return iterator{this, size_};
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator{this, size_};
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость вектора
+    size_t Capacity() const noexcept {
+        return blocks_.Size() * BlockSize;
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return (0 == size_);
+    }
+
+    // Резервирует блоки под new_capacity элементов.
+    // Уже построенные элементы остаются на своих адресах
+    void Reserve(size_t new_capacity) {
+        while (Capacity() < new_capacity) {
+            blocks_.EmplaceBack(RawMemory<T, Alloc>(BlockSize));
+        }
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return blocks_[index / BlockSize][index % BlockSize];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    // Перемещает элемент в конец вектора
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Конструирует элемент в конце вектора. Рост выделяет новый блок,
+    // не трогая существующие элементы
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            blocks_.EmplaceBack(RawMemory<T, Alloc>(BlockSize));
+        }
+        T* entry = std::construct_at(
+            blocks_[size_ / BlockSize]+size_ % BlockSize,
+            std::forward<Args>(args)...);
+        ++size_;
+        return *entry;
+    }
+
+    // "Удаляет" последний элемент вектора. Пустые блоки сохраняются
+    // для повторного использования
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            --size_;
+            DestroyN(blocks_[size_ / BlockSize]+size_ % BlockSize, 1);
+        }
+    }
+
+    // Изменяет размер вектора
+    void Resize(size_t new_size) {
+        while (size_ > new_size) {
+            PopBack();
+        }
+        Reserve(new_size);
+        while (size_ < new_size) {
+            EmplaceBack();
+        }
+    }
+
+    // Очищает вектор, сохраняя выделенные блоки
+    void Clear() noexcept {
+        while (size_ > 0) {
+            PopBack();
+        }
+    }
+
+private:
+    Vector<RawMemory<T, Alloc>> blocks_;
+    size_t size_ = 0;
+};
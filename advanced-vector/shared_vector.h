@@ -0,0 +1,131 @@
+#pragma once
+#include "vector.h"
+
+#include <memory>
+
+// Вектор с разделяемыми снимками: копирование — это O(1) подъём
+// счётчика ссылок, глубокое копирование откладывается до первой
+// модификации разделяемого буфера (copy-on-write). Читатели держат
+// согласованный снимок, пока писатель продолжает дописывать свой
+// экземпляр. Дисциплина потоков обычная для COW: один писатель,
+// снимки раздаются читателям как значения
+template <typename T, typename Alloc = std::allocator<T>>
+class SharedVector {
+public:
+    using const_iterator = typename Vector<T, Alloc>::const_iterator;
+
+    SharedVector()
+        : storage_(std::make_shared<Vector<T, Alloc>>()) {
+    }
+
+    // Создаёт вектор из size элементов
+    explicit SharedVector(size_t size)
+        : storage_(std::make_shared<Vector<T, Alloc>>(size)) {
+    }
+
+    // Копии разделяют буфер; стоимость не зависит от размера
+    SharedVector(const SharedVector&) = default;
+    SharedVector& operator=(const SharedVector&) = default;
+    SharedVector(SharedVector&&) noexcept = default;
+    SharedVector& operator=(SharedVector&&) noexcept = default;
+
+    // Возвращает снимок текущего состояния за O(1)
+    SharedVector Snapshot() const noexcept {
+        return *this;
+    }
+
+    // Сообщает, разделён ли буфер с другими экземплярами
+    bool IsShared() const noexcept {
+        return storage_.use_count() > 1;
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t Size() const noexcept {
+        return storage_->Size();
+    }
+
+    // Возвращает вместимость вектора
+    size_t Capacity() const noexcept {
+        return storage_->Capacity();
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return storage_->IsEmpty();
+    }
+
+    // Чтение не отцепляет буфер
+    const T& operator[](size_t index) const noexcept {
+        return std::as_const(*storage_)[index];
+    }
+
+    const_iterator begin() const noexcept {
+        return storage_->cbegin();
+    }
+
+    const_iterator end() const noexcept {
+        return storage_->cend();
+    }
+
+    // Возвращает ссылку на элемент для записи, предварительно
+    // отцепив разделяемый буфер
+    T& Mutable(size_t index) {
+        Detach();
+        return (*storage_)[index];
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const T& value) {
+        Detach();
+        storage_->PushBack(value);
+    }
+
+    // Перемещает элемент в конец вектора
+    void PushBack(T&& value) {
+        Detach();
+        storage_->PushBack(std::move(value));
+    }
+
+    // Конструирует элемент в конце вектора
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        Detach();
+        return storage_->EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // "Удаляет" последний элемент вектора
+    void PopBack() {
+        Detach();
+        storage_->PopBack();
+    }
+
+    // Изменяет размер вектора
+    void Resize(size_t new_size) {
+        Detach();
+        storage_->Resize(new_size);
+    }
+
+    // Очищает вектор
+    void Clear() {
+        Detach();
+        storage_->Clear();
+    }
+
+    // Резервирует место
+    void Reserve(size_t new_capacity) {
+        Detach();
+        storage_->Reserve(new_capacity);
+    }
+
+private:
+    // Отцепляет буфер от снимков: пока он разделён, модификация
+    // сначала делает глубокую копию существующей реализацией
+    // копирующего конструктора Vector
+    void Detach() {
+        if (storage_.use_count() > 1) {
+            storage_ = std::make_shared<Vector<T, Alloc>>(*storage_);
+        }
+    }
+
+    std::shared_ptr<Vector<T, Alloc>> storage_;
+};
@@ -0,0 +1,233 @@
+#pragma once
+#include "vector.h"
+
+// Вектор с оптимизацией малого буфера: до N элементов хранятся
+// внутри самого объекта без обращения к куче, и только при
+// превышении N содержимое переезжает в RawMemory
+template <typename T, size_t N, typename Alloc = std::allocator<T>>
+class SmallVector {
+    static_assert(N > 0, "Размер встроенного буфера должен быть больше нуля");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+
+    // Создаёт вектор из size элементов
+    explicit SmallVector(size_t size, const Alloc& alloc = Alloc{})
+        : heap_(alloc)
+    {
+        if (size > N) {
+            heap_ = RawMemory<T, Alloc>(size, alloc);
+            data_ = heap_.GetAddress();
+            capacity_ = size;
+        }
+        std::uninitialized_value_construct_n(data_, size);
+        size_ = size;
+    }
+
+    // Конструктор копирования
+    SmallVector(const SmallVector& other)
+        : heap_(other.heap_.GetAllocator())
+    {
+        if (other.size_ > N) {
+            heap_ = RawMemory<T, Alloc>(other.size_, other.heap_.GetAllocator());
+            data_ = heap_.GetAddress();
+            capacity_ = other.size_;
+        }
+        std::uninitialized_copy_n(other.data_, other.size_, data_);
+        size_ = other.size_;
+    }
+
+    // Конструктор перемещения. Куча крадётся без копирования,
+    // элементы встроенного буфера переносятся поэлементно
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.IsInline()) {
+            // Во встроенном буфере не может лежать больше N элементов
+            const size_t count = other.size_ <= N ? other.size_ : N;
+            std::uninitialized_move_n(other.data_, count, data_);
+            DestroyN(other.data_, count);
+        }
+        else {
+            heap_ = std::move(other.heap_);
+            data_ = heap_.GetAddress();
+            capacity_ = heap_.Capacity();
+            other.data_ = other.InlineBuffer();
+            other.capacity_ = N;
+        }
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Оператор присваивания копированием
+    SmallVector& operator=(const SmallVector& rhs) {
+        if (this != &rhs) {
+            SmallVector rhs_copy(rhs);
+            *this = std::move(rhs_copy);
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением
+    SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &rhs) {
+            DestroyN(data_, size_);
+            size_ = 0;
+            data_ = InlineBuffer();
+            capacity_ = N;
+            if (rhs.IsInline()) {
+                // Прежняя куча больше не нужна — возвращаем её аллокатору
+                heap_ = RawMemory<T, Alloc>(heap_.GetAllocator());
+                // Во встроенном буфере не может лежать больше N элементов
+                const size_t count = rhs.size_ <= N ? rhs.size_ : N;
+                std::uninitialized_move_n(rhs.data_, count, data_);
+                DestroyN(rhs.data_, count);
+            }
+            else {
+                heap_ = std::move(rhs.heap_);
+                data_ = heap_.GetAddress();
+                capacity_ = heap_.Capacity();
+                rhs.data_ = rhs.InlineBuffer();
+                rhs.capacity_ = N;
+            }
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        DestroyN(data_, size_);
+    }
+
+    // Возвращает итератор на начало вектора
+    iterator begin() noexcept {
+        return iterator{data_};
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    iterator end() noexcept {
+        return iterator{data_+size_};
+    }
+
+    // Возвращает константный итератор на начало вектора
+    const_iterator begin() const noexcept {
+        return const_iterator{data_};
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    const_iterator end() const noexcept {
+        return const_iterator{data_+size_};
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость вектора
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return (0 == size_);
+    }
+
+    // Сообщает, хранятся ли элементы во встроенном буфере
+    bool IsInline() const noexcept {
+        return data_ == InlineBuffer();
+    }
+
+    // Резервирует место
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= capacity_) {
+            return;
+        }
+        RawMemory<T, Alloc> new_data(new_capacity, heap_.GetAllocator());
+        RelocateN(data_, size_, new_data.GetAddress());
+        heap_ = std::move(new_data);
+        data_ = heap_.GetAddress();
+        capacity_ = heap_.Capacity();
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    // Изменяет размер вектора
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyN(data_+new_size, size_-new_size);
+            size_ = new_size;
+        }
+        else {
+            Reserve(new_size);
+            std::uninitialized_value_construct_n(data_+size_, new_size-size_);
+            size_ = new_size;
+        }
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const T& value) {
+        EmplaceBack(std::forward<const T&>(value));
+    }
+
+    // Перемещает элемент в конец вектора
+    void PushBack(T&& value) {
+        EmplaceBack(std::forward<T&&>(value));
+    }
+
+    // Перемещает значения args в конец вектора
+    // Возвращает значение
+    template<typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        T* entry = nullptr;
+        if (size_ == capacity_) {
+            RawMemory<T, Alloc> new_data(capacity_ * 2, heap_.GetAllocator());
+            entry = new (new_data+size_) T(std::forward<Args>(args)...);
+            RelocateN(data_, size_, new_data.GetAddress());
+            heap_ = std::move(new_data);
+            data_ = heap_.GetAddress();
+            capacity_ = heap_.Capacity();
+        }
+        else {
+            entry = new (data_+size_) T(std::forward<Args>(args)...);
+        }
+        ++size_;
+        return *entry;
+    }
+
+    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::destroy_at(data_+size_-1);
+            }
+            --size_;
+        }
+    }
+
+private:
+    // Возвращает указатель на начало встроенного буфера
+    T* InlineBuffer() noexcept {
+        return reinterpret_cast<T*>(inline_buf_);
+    }
+
+    const T* InlineBuffer() const noexcept {
+        return reinterpret_cast<const T*>(inline_buf_);
+    }
+
+    alignas(T) char inline_buf_[N * sizeof(T)];
+    RawMemory<T, Alloc> heap_;
+    T* data_ = InlineBuffer();
+    size_t size_ = 0;
+    size_t capacity_ = N;
+};
@@ -0,0 +1,292 @@
+#pragma once
+#include "vector.h"
+
+#include <span>
+#include <tuple>
+
+// Вектор в раскладке "структура массивов": для каждого поля Ts
+// ведётся собственный RawMemory при общем размере и вместимости.
+// Проходы по одному полю тянут из памяти только его данные,
+// поэтому сканы хорошо векторизуются и не греют кэш чужими полями
+template <typename... Ts>
+class SoaVector {
+    static_assert(sizeof...(Ts) > 0, "Нужно хотя бы одно поле");
+
+public:
+    // Тип поля с номером I
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    SoaVector() = default;
+
+    SoaVector(const SoaVector&) = delete;
+    SoaVector& operator=(const SoaVector&) = delete;
+
+    SoaVector(SoaVector&& other) noexcept
+        : data_(std::move(other.data_))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0)) {
+    }
+
+    SoaVector& operator=(SoaVector&& rhs) noexcept {
+        if (this != &rhs) {
+            DestroyAll();
+            data_ = std::move(rhs.data_);
+            size_ = std::exchange(rhs.size_, 0);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+        }
+        return *this;
+    }
+
+    ~SoaVector() {
+        DestroyAll();
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость вектора
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return (0 == size_);
+    }
+
+    // Резервирует место во всех массивах полей
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= capacity_) {
+            return;
+        }
+        Grow(new_capacity);
+    }
+
+    // Добавляет строку в конец вектора: по одному значению на поле
+    void PushBack(const Ts&... values) {
+        EmplaceBack(values...);
+    }
+
+    // Конструирует строку в конце вектора из одного
+    // инициализатора на каждое поле. Аргументы могут ссылаться на
+    // элементы самого вектора: при росте строка строится в новых
+    // буферах до разрушения старых — как в Vector::EmplaceBack
+    template <typename... Us>
+    void EmplaceBack(Us&&... values) {
+        static_assert(sizeof...(Us) == sizeof...(Ts),
+                      "Нужен один инициализатор на каждое поле");
+        if (size_ == capacity_) {
+            GrowWithRow(capacity_ == 0 ? 1 : capacity_ * 2, std::forward<Us>(values)...);
+        }
+        else {
+            ConstructRowInto(data_, std::index_sequence_for<Ts...>{},
+                             std::forward<Us>(values)...);
+        }
+        ++size_;
+    }
+
+    // "Удаляет" последнюю строку вектора
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            --size_;
+            ForEachField([this](auto field_index) noexcept {
+                constexpr size_t I = decltype(field_index)::value;
+                DestroyN(FieldPtr<I>()+size_, 1);
+            });
+        }
+    }
+
+    // Очищает вектор, не изменяя вместимость
+    void Clear() noexcept {
+        DestroyAll();
+        size_ = 0;
+    }
+
+    // Возвращает указатель на начало массива поля I
+    template <size_t I>
+    FieldType<I>* Field() noexcept {
+        return FieldPtr<I>();
+    }
+
+    template <size_t I>
+    const FieldType<I>* Field() const noexcept {
+        return std::get<I>(data_).GetAddress();
+    }
+
+    // Возвращает массив поля I как span из Size() элементов
+    template <size_t I>
+    std::span<FieldType<I>> FieldSpan() noexcept {
+        return {FieldPtr<I>(), size_};
+    }
+
+    template <size_t I>
+    std::span<const FieldType<I>> FieldSpan() const noexcept {
+        return {std::get<I>(data_).GetAddress(), size_};
+    }
+
+    // Возвращает ссылку на значение поля I в строке index
+    template <size_t I>
+    FieldType<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return FieldPtr<I>()[index];
+    }
+
+    template <size_t I>
+    const FieldType<I>& Get(size_t index) const noexcept {
+        return const_cast<SoaVector&>(*this).Get<I>(index);
+    }
+
+    // Возвращает кортеж ссылок на все поля строки index
+    std::tuple<Ts&...> operator[](size_t index) noexcept {
+        assert(index < size_);
+        return RowAt(index, std::index_sequence_for<Ts...>{});
+    }
+
+    std::tuple<const Ts&...> operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return const_cast<SoaVector&>(*this).ConstRowAt(index, std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    // Вызывает fn(константу с номером поля) для каждого поля
+    template <typename Fn>
+    void ForEachField(Fn fn) {
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+            (fn(std::integral_constant<size_t, Is>{}), ...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+    template <size_t I>
+    FieldType<I>* FieldPtr() noexcept {
+        return std::get<I>(data_).GetAddress();
+    }
+
+    // Переносит все массивы полей в новые буферы вместимости
+    // new_capacity. Сначала содержимое всех полей копируется или
+    // перемещается без разрушения источников, и только после успеха
+    // старые элементы разрушаются — иначе исключение на середине
+    // оставило бы поля разной длины
+    void Grow(size_t new_capacity) {
+        std::tuple<RawMemory<Ts>...> new_data{RawMemory<Ts>(new_capacity)...};
+        size_t fields_done = 0;
+        try {
+            ForEachField([&](auto field_index) {
+                constexpr size_t I = decltype(field_index)::value;
+                RelocateKeepSource(FieldPtr<I>(), size_,
+                                   std::get<I>(new_data).GetAddress());
+                ++fields_done;
+            });
+        } catch (...) {
+            ForEachField([&](auto field_index) {
+                constexpr size_t I = decltype(field_index)::value;
+                if (I < fields_done) {
+                    DestroyN(std::get<I>(new_data).GetAddress(), size_);
+                }
+            });
+            throw;
+        }
+        DestroyAll();
+        data_ = std::move(new_data);
+        capacity_ = new_capacity;
+    }
+
+    // Рост с одновременной дозаписью строки: строка конструируется
+    // в новых буферах до переноса и разрушения старых, поэтому её
+    // инициализаторы могут ссылаться на элементы самого вектора
+    template <typename... Us>
+    void GrowWithRow(size_t new_capacity, Us&&... values) {
+        std::tuple<RawMemory<Ts>...> new_data{RawMemory<Ts>(new_capacity)...};
+        ConstructRowInto(new_data, std::index_sequence_for<Ts...>{},
+                         std::forward<Us>(values)...);
+        size_t fields_done = 0;
+        try {
+            ForEachField([&](auto field_index) {
+                constexpr size_t I = decltype(field_index)::value;
+                RelocateKeepSource(FieldPtr<I>(), size_,
+                                   std::get<I>(new_data).GetAddress());
+                ++fields_done;
+            });
+        } catch (...) {
+            ForEachField([&](auto field_index) {
+                constexpr size_t I = decltype(field_index)::value;
+                if (I < fields_done) {
+                    DestroyN(std::get<I>(new_data).GetAddress(), size_);
+                }
+                DestroyN(std::get<I>(new_data).GetAddress()+size_, 1);
+            });
+            throw;
+        }
+        DestroyAll();
+        data_ = std::move(new_data);
+        capacity_ = new_capacity;
+    }
+
+    // Переносит count элементов в сырую память to, не разрушая
+    // источник: разрушение откладывается до успеха всех полей.
+    // Путь memcpy в отличие от RelocateN требует тривиального
+    // деструктора: после успеха DestroyAll разрушит источники,
+    // и для типа с ресурсами это освободило бы их дважды
+    template <typename T>
+    static void RelocateKeepSource(T* from, size_t count, T* to) {
+        if constexpr (IsTriviallyRelocatable<T>::value &&
+                      std::is_trivially_destructible_v<T>) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+            }
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                           AssumeNothrowMove<T>::value ||
+                          !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(from, count, to);
+        }
+        else {
+            std::uninitialized_copy_n(from, count, to);
+        }
+    }
+
+    // Конструирует одну строку в позиции size_ буферов dst;
+    // при исключении разрушает уже построенные значения этой строки
+    template <size_t... Is, typename... Us>
+    void ConstructRowInto(std::tuple<RawMemory<Ts>...>& dst,
+                          std::index_sequence<Is...>, Us&&... values) {
+        size_t fields_done = 0;
+        try {
+            ((std::construct_at(std::get<Is>(dst).GetAddress()+size_,
+                                std::forward<Us>(values)),
+              ++fields_done), ...);
+        } catch (...) {
+            ForEachField([&](auto field_index) {
+                constexpr size_t I = decltype(field_index)::value;
+                if (I < fields_done) {
+                    DestroyN(std::get<I>(dst).GetAddress()+size_, 1);
+                }
+            });
+            throw;
+        }
+    }
+
+    template <size_t... Is>
+    std::tuple<Ts&...> RowAt(size_t index, std::index_sequence<Is...>) noexcept {
+        return std::tie(FieldPtr<Is>()[index]...);
+    }
+
+    template <size_t... Is>
+    std::tuple<const Ts&...> ConstRowAt(size_t index, std::index_sequence<Is...>) noexcept {
+        return std::tie(std::as_const(FieldPtr<Is>()[index])...);
+    }
+
+    // Разрушает элементы всех полей
+    void DestroyAll() noexcept {
+        ForEachField([this](auto field_index) noexcept {
+            constexpr size_t I = decltype(field_index)::value;
+            DestroyN(FieldPtr<I>(), size_);
+        });
+    }
+
+    std::tuple<RawMemory<Ts>...> data_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
@@ -0,0 +1,146 @@
+#pragma once
+#include "vector.h"
+
+#include <functional>
+
+// Отсортированный вектор поверх Vector: элементы хранятся
+// по возрастанию относительно Compare, поиск — двоичный по
+// непрерывной памяти. Одиночная вставка платит обычный сдвиг хвоста,
+// а пакетная InsertSortedBatch сливает сразу весь пакет одним
+// обратным проходом — O(n+k) перемещений вместо O(n*k)
+template <typename T, typename Compare = std::less<T>>
+class SortedVector {
+public:
+    using const_iterator = typename Vector<T>::const_iterator;
+
+    SortedVector() = default;
+
+    explicit SortedVector(Compare cmp)
+        : cmp_(std::move(cmp)) {
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t Size() const noexcept {
+        return data_.Size();
+    }
+
+    // Возвращает вместимость вектора
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return data_.IsEmpty();
+    }
+
+    // Доступ только на чтение: запись могла бы нарушить порядок
+    const T& operator[](size_t index) const noexcept {
+        return data_[index];
+    }
+
+    const_iterator begin() const noexcept {
+        return data_.cbegin();
+    }
+
+    const_iterator end() const noexcept {
+        return data_.cend();
+    }
+
+    // Резервирует место
+    void Reserve(size_t new_capacity) {
+        data_.Reserve(new_capacity);
+    }
+
+    // Возвращает итератор на первый элемент не меньше value
+    const_iterator LowerBound(const T& value) const {
+        return std::lower_bound(begin(), end(), value, cmp_);
+    }
+
+    // Возвращает итератор на первый элемент больше value
+    const_iterator UpperBound(const T& value) const {
+        return std::upper_bound(begin(), end(), value, cmp_);
+    }
+
+    // Возвращает итератор на элемент, эквивалентный value,
+    // либо end(), если такого нет
+    const_iterator Find(const T& value) const {
+        const_iterator pos = LowerBound(value);
+        if (pos != end() && !cmp_(value, *pos)) {
+            return pos;
+        }
+        return end();
+    }
+
+    // Сообщает, есть ли в векторе элемент, эквивалентный value
+    bool Contains(const T& value) const {
+        return Find(value) != end();
+    }
+
+    // Вставляет значение с сохранением порядка.
+    // Возвращает итератор на вставленный элемент
+    const_iterator InsertSorted(const T& value) {
+        return data_.Insert(UpperBound(value), value);
+    }
+
+    const_iterator InsertSorted(T&& value) {
+        return data_.Insert(UpperBound(value), std::move(value));
+    }
+
+    // Вставляет пакет значений [first, last) за один обратный проход
+    // слияния: каждый существующий элемент сдвигается не более
+    // одного раза независимо от размера пакета
+    template <typename InputIt>
+    void InsertSortedBatch(InputIt first, InputIt last) {
+        Vector<T> batch;
+        batch.AppendRange(first, last);
+        if (batch.IsEmpty()) {
+            return;
+        }
+        std::sort(batch.begin(), batch.end(), cmp_);
+
+        const size_t old_size = data_.Size();
+        const size_t batch_size = batch.Size();
+        data_.Reserve(old_size+batch_size);
+        T* values = data_.Data();
+
+        // Обратное слияние: хвостовые позиции [old_size, old_size+k)
+        // ещё не сконструированы, позиции ниже — живые элементы
+        size_t write = old_size+batch_size;
+        size_t i = old_size;
+        size_t j = batch_size;
+        while (j > 0) {
+            --write;
+            T* source = (i > 0 && cmp_(batch[j-1], values[i-1]))
+                ? &values[--i]
+                : &batch[--j];
+            if (write >= old_size) {
+                std::construct_at(values+write, std::move(*source));
+            }
+            else {
+                values[write] = std::move(*source);
+            }
+        }
+        data_.SetSizeUnchecked(old_size+batch_size);
+    }
+
+    // Удаляет элемент в позиции pos
+    const_iterator Erase(const_iterator pos) {
+        return data_.Erase(pos);
+    }
+
+    // Удаляет один элемент, эквивалентный value.
+    // Возвращает true, если элемент был найден и удалён
+    bool EraseValue(const T& value) {
+        const_iterator pos = Find(value);
+        if (pos == end()) {
+            return false;
+        }
+        data_.Erase(pos);
+        return true;
+    }
+
+private:
+    Vector<T> data_;
+    Compare cmp_{};
+};
@@ -1,122 +1,406 @@
 #pragma once
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <new>
 #include <utility>
 #include <memory>
+#include <span>
+#include <istream>
+#include <ostream>
 #include <iterator>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
 
-template <typename T>
+// Уровень проверок индексов в operator[] и внутренних операциях:
+//   0 — проверок нет даже в отладочной сборке (горячие циклы),
+//   1 — assert, как раньше: проверки исчезают вместе с NDEBUG,
+//   2 — проверка с abort в любой сборке (полузащищённые стенды).
+// Выбирается на этапе компиляции независимо от NDEBUG
+#ifndef ADVANCED_VECTOR_HARDENING
+#define ADVANCED_VECTOR_HARDENING 1
+#endif
+
+#if ADVANCED_VECTOR_HARDENING == 0
+#define ADVANCED_VECTOR_VERIFY(expr) ((void)0)
+#elif ADVANCED_VECTOR_HARDENING == 1
+#define ADVANCED_VECTOR_VERIFY(expr) assert(expr)
+#else
+#define ADVANCED_VECTOR_VERIFY(expr) ((expr) ? (void)0 : std::abort())
+#endif
+
+template <typename T, typename Alloc = std::allocator<T>>
 class RawMemory {
 public:
-    RawMemory() = default;
+    // Освободитель внешнего буфера: получает адрес и вместимость
+    using Deleter = void (*)(T*, size_t);
+
+    constexpr RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    constexpr explicit RawMemory(const Alloc& alloc) noexcept
+        : alloc_(alloc) {
+    }
+
+    constexpr explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc{})
+        : alloc_(alloc)
+        , buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
+    // Принимает во владение внешний буфер: освобождаться он будет
+    // не аллокатором, а переданным deleter
+    constexpr RawMemory(T* buffer, size_t capacity, Deleter deleter, const Alloc& alloc = Alloc{}) noexcept
+        : alloc_(alloc)
+        , buffer_(buffer)
+        , capacity_(capacity)
+        , deleter_(deleter) {
+    }
+
     RawMemory(const RawMemory&) = delete;
 
-    RawMemory(RawMemory&& other) noexcept {
-        buffer_ = std::move(other.GetAddress());
-        capacity_ = std::move(other.Capacity());
+    constexpr RawMemory(RawMemory&& other) noexcept
+        : alloc_(std::move(other.alloc_))
+        , buffer_(std::exchange(other.buffer_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , deleter_(std::exchange(other.deleter_, nullptr)) {
     }
 
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
-    RawMemory& operator=(RawMemory&& rhs) noexcept {
-        buffer_ = std::move(rhs.GetAddress());
-        capacity_ = std::move(rhs.Capacity());
+    constexpr RawMemory& operator=(RawMemory&& rhs) noexcept {
+        if (this != &rhs) {
+            Deallocate(buffer_, capacity_);
+            alloc_ = std::move(rhs.alloc_);
+            buffer_ = std::exchange(rhs.buffer_, nullptr);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+            deleter_ = std::exchange(rhs.deleter_, nullptr);
+        }
         return *this;
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    constexpr ~RawMemory() {
+        Deallocate(buffer_, capacity_);
     }
 
-    T* operator+(size_t offset) noexcept {
+    constexpr T* operator+(size_t offset) noexcept {
         // Разрешается получать адрес ячейки памяти, следующей за последним элементом вектора
-        assert(offset <= capacity_);
+        ADVANCED_VECTOR_VERIFY(offset <= capacity_);
         return buffer_+offset;
     }
 
-    const T* operator+(size_t offset) const noexcept {
+    constexpr const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this)+offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    constexpr const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
-        assert(index < capacity_);
+    constexpr T& operator[](size_t index) noexcept {
+        ADVANCED_VECTOR_VERIFY(index < capacity_);
         return buffer_[index];
     }
 
-    void Swap(RawMemory& other) noexcept {
+    constexpr void Swap(RawMemory& other) noexcept {
+        std::swap(alloc_, other.alloc_);
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
+        std::swap(deleter_, other.deleter_);
     }
 
-    const T* GetAddress() const noexcept {
+    constexpr const T* GetAddress() const noexcept {
         return buffer_;
     }
 
-    T* GetAddress() noexcept {
+    constexpr T* GetAddress() noexcept {
         return buffer_;
     }
 
-    size_t Capacity() const {
+    constexpr size_t Capacity() const {
         return capacity_;
     }
 
+    // Возвращает используемый аллокатор
+    constexpr const Alloc& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Возвращает освободитель внешнего буфера
+    // (nullptr, если память выделена аллокатором)
+    constexpr Deleter GetDeleter() const noexcept {
+        return deleter_;
+    }
+
+    // Отсоединяет буфер, не освобождая его.
+    // Владение передаётся вызывающему коду
+    constexpr T* Detach() noexcept {
+        capacity_ = 0;
+        deleter_ = nullptr;
+        return std::exchange(buffer_, nullptr);
+    }
+
 private:
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    constexpr T* Allocate(size_t n) {
+        return n != 0 ? std::allocator_traits<Alloc>::allocate(alloc_, n) : nullptr;
     }
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Освобождает сырую память: внешний буфер — через deleter,
+    // собственный — через аллокатор
+    constexpr void Deallocate(T* buf, size_t n) noexcept {
+        if (buf == nullptr) {
+            return;
+        }
+        if (deleter_ != nullptr) {
+            deleter_(buf, n);
+        }
+        else {
+            std::allocator_traits<Alloc>::deallocate(alloc_, buf, n);
+        }
     }
 
+    Alloc alloc_{};
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
+    Deleter deleter_ = nullptr;
+};
+
+// Буфер, отсоединённый от вектора через ReleaseBuffer. Если deleter
+// равен nullptr, память была выделена аллокатором вектора и должна
+// быть возвращена совместимым аллокатором (по capacity элементов)
+template <typename T>
+struct ReleasedBuffer {
+    T* ptr = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    typename RawMemory<T>::Deleter deleter = nullptr;
+};
+
+// Заголовок двоичного снимка вектора: по нему при загрузке
+// распознаётся чужой формат и несовпадающая раскладка элемента
+struct VectorSnapshotHeader {
+    uint64_t magic = 0;
+    uint64_t element_size = 0;
+    uint64_t element_align = 0;
+    uint64_t size = 0;
+};
+
+inline constexpr uint64_t VECTOR_SNAPSHOT_MAGIC = 0x544345565f444156ull;  // "VAD_VECT"
+
+// Типовая характеристика: объявляет тип побитово перемещаемым —
+// при реаллокации его элементы переносятся одним memcpy без вызова
+// конструкторов и деструкторов. По умолчанию верна для тривиально
+// копируемых типов; специализируется для собственных типов, чьё
+// значение не зависит от адреса объекта
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+// Типовая характеристика: обещает, что перемещающий конструктор типа
+// на деле не бросает исключений, хотя и не помечен noexcept.
+// Специализируется для легаси-типов, чтобы реаллокация перемещала
+// их вместо полного копирования
+template <typename T>
+struct AssumeNothrowMove : std::false_type {};
+
+// Переносит count элементов из сырой памяти from в сырую память to
+// и разрушает исходные. Побитово перемещаемые типы переносятся одним
+// memcpy без разрушения источника, остальные перемещаются либо
+// копируются поэлементно
+template <typename T>
+constexpr void RelocateN(T* from, size_t count, T* to) {
+    if (std::is_constant_evaluated()) {
+        // В константных вычислениях memcpy недоступен,
+        // элементы переносятся перемещением поэлементно
+        for (size_t i = 0; i < count; ++i) {
+            std::construct_at(to+i, std::move(from[i]));
+        }
+        std::destroy_n(from, count);
+        return;
+    }
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+        }
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                       AssumeNothrowMove<T>::value ||
+                      !std::is_copy_constructible_v<T>) {
+        std::uninitialized_move_n(from, count, to);
+        std::destroy_n(from, count);
+    }
+    else {
+        std::uninitialized_copy_n(from, count, to);
+        std::destroy_n(from, count);
+    }
+}
+
+// constexpr-совместимое конструирование count элементов по умолчанию
+// в сырой памяти начиная с from
+template <typename T>
+constexpr void ValueConstructN(T* from, size_t count) {
+    if (std::is_constant_evaluated()) {
+        for (size_t i = 0; i < count; ++i) {
+            std::construct_at(from+i);
+        }
+    }
+    else {
+        std::uninitialized_value_construct_n(from, count);
+    }
+}
+
+// constexpr-совместимое конструирование копий диапазона [first, last)
+// в сырой памяти начиная с to
+template <typename InputIt, typename T>
+constexpr void CopyConstruct(InputIt first, InputIt last, T* to) {
+    if (std::is_constant_evaluated()) {
+        for (; first != last; ++first, ++to) {
+            std::construct_at(to, *first);
+        }
+    }
+    else {
+        std::uninitialized_copy(first, last, to);
+    }
+}
+
+// constexpr-совместимое перемещение диапазона [first, last)
+// в сырую память начиная с to
+template <typename T>
+constexpr void UninitializedMove(T* first, T* last, T* to) {
+    if (std::is_constant_evaluated()) {
+        for (; first != last; ++first, ++to) {
+            std::construct_at(to, std::move(*first));
+        }
+    }
+    else {
+        std::uninitialized_move(first, last, to);
+    }
+}
+
+// Размер кэш-линии — шаг программной предвыборки
+inline constexpr size_t CACHE_LINE_BYTES = 64;
+
+// Предвыбирает кэш-линии диапазона из count элементов начиная с from
+template <typename T>
+void PrefetchRange(const T* from, size_t count) noexcept {
+    if (count == 0) {
+        return;
+    }
+    const char* ptr = reinterpret_cast<const char*>(from);
+    const char* end = reinterpret_cast<const char*>(from+count);
+    for (; ptr < end; ptr += CACHE_LINE_BYTES) {
+        __builtin_prefetch(ptr, 0, 3);
+    }
+}
+
+// Политика роста вместимости: удвоение (исторический режим Vector)
+struct GrowthX2 {
+    static constexpr size_t Next(size_t capacity, size_t /*element_size*/) noexcept {
+        return capacity == 0 ? 1 : capacity * 2;
+    }
+};
+
+// Политика роста в полтора раза — меньше пиковый перерасход памяти
+// на долгоживущих больших векторах
+struct GrowthX15 {
+    static constexpr size_t Next(size_t capacity, size_t /*element_size*/) noexcept {
+        return capacity < 2 ? capacity+1 : capacity+capacity / 2;
+    }
+};
+
+// Политика роста с округлением вместимости вверх до целого числа
+// страниц по PageBytes байт
+template <size_t PageBytes = 4096>
+struct GrowthPaged {
+    static constexpr size_t Next(size_t capacity, size_t element_size) noexcept {
+        const size_t wanted = (capacity == 0 ? 1 : capacity * 2) * element_size;
+        const size_t pages = (wanted+PageBytes-1) / PageBytes;
+        return pages * PageBytes / element_size;
+    }
 };
 
+// Политика роста шагами, кратными крупной странице (2МБ):
+// в паре с HugePageAllocator реаллокация не дробит отображение
+using GrowthHugePage = GrowthPaged<2 * 1024 * 1024>;
+
+#ifdef ADVANCED_VECTOR_STATS
+// Счётчики памяти одного вектора. Собираются только при сборке
+// с -DADVANCED_VECTOR_STATS, иначе инструментирование не
+// генерирует ни байта кода
+struct VectorStats {
+    size_t allocations = 0;       // число выделений памяти
+    size_t bytes_requested = 0;   // суммарно запрошено байт
+    size_t reallocations = 0;     // число переездов содержимого
+    size_t elements_moved = 0;    // элементов перенесено перемещением
+    size_t elements_copied = 0;   // элементов перенесено копированием
+    size_t peak_capacity = 0;     // пиковая вместимость
+};
+
+// Необязательный глобальный хук: вызывается после каждого выделения
+// памяти любым вектором, получая его накопленные счётчики
+using VectorStatsCallback = void (*)(const VectorStats&);
+inline VectorStatsCallback g_vector_stats_callback = nullptr;
+#endif
+
+// Разрушает count элементов, начиная с from. Для тривиально
+// разрушаемых типов не генерирует кода вовсе
 template <typename T>
+constexpr void DestroyN(T* from, size_t count) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        std::destroy_n(from, count);
+    }
+}
+
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = GrowthX2>
 class Vector {
 public:
     using iterator = T*;
     using const_iterator = const T*;
 
-    Vector() = default;
+    constexpr Vector() = default;
+
+    // Создаёт пустой вектор, использующий аллокатор alloc
+    constexpr explicit Vector(const Alloc& alloc) noexcept
+        : data_(alloc)
+    {
+    }
+
+    // Создаёт пустой вектор поверх ранее выделенного хранилища —
+    // парная операция к ReleaseStorage (см. VectorPool)
+    constexpr explicit Vector(RawMemory<T, Alloc>&& storage) noexcept
+        : data_(std::move(storage))
+    {
+    }
 
     // Создаёт вектор из size элементов
-    explicit Vector(size_t size)
-        : data_(size)
+    constexpr explicit Vector(size_t size, const Alloc& alloc = Alloc{})
+        : data_(size, alloc)
         , size_(size)
     {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size);
-    }  
+        ValueConstructN(data_.GetAddress(), size);
+        RecordAllocation(size);
+    }
 
     // Конструктор копирования
-    Vector(const Vector& other)
-        : data_(other.size_)
+    constexpr Vector(const Vector& other)
+        : data_(other.size_, other.data_.GetAllocator())
         , size_(other.size_)
     {
-        std::uninitialized_copy_n(other.begin(), size_, data_.GetAddress());
+        CopyConstruct(other.begin(), other.end(), data_.GetAddress());
+        RecordAllocation(size_);
     }
 
     // Конструктор перемещения
-    Vector(Vector&& other) noexcept {
-        Swap(other);
+    constexpr Vector(Vector&& other) noexcept
+        : data_(std::move(other.data_))
+        , size_(std::exchange(other.size_, 0))
+    {
     }
 
     // Оператор присваивания копированием
-    Vector& operator=(const Vector& rhs) {
+    constexpr Vector& operator=(const Vector& rhs) {
         if (this != &rhs) {
             if (data_.Capacity() < rhs.size_) {
                 Vector rhs_copy(rhs);
@@ -128,16 +412,16 @@ public:
                               rhs.data_.GetAddress()+rhs.size_,
                               data_.GetAddress());
 
-                    std::destroy_n(data_.GetAddress()+rhs.size_, size_-rhs.size_);
+                    DestroyN(data_.GetAddress()+rhs.size_, size_-rhs.size_);
                 }
                 else {
                     std::copy(rhs.data_.GetAddress(),
                               rhs.data_.GetAddress()+size_,
                               data_.GetAddress());
 
-                    std::uninitialized_copy_n(rhs.data_.GetAddress()+size_,
-                                              rhs.size_-size_,
-                                              data_.GetAddress()+size_);
+                    CopyConstruct(rhs.data_.GetAddress()+size_,
+                                  rhs.data_.GetAddress()+rhs.size_,
+                                  data_.GetAddress()+size_);
                 }
                 size_ = rhs.size_;
             }
@@ -146,7 +430,7 @@ public:
     }
 
     // Оператор присваивания перемещением
-    Vector& operator=(Vector&& rhs) noexcept {
+    constexpr Vector& operator=(Vector&& rhs) noexcept {
         if (this != &rhs) {
             Swap(rhs);
         }
@@ -154,142 +438,405 @@ public:
     }
 
     // Возвращает итератор на начало вектора
-    iterator begin() noexcept {
+    constexpr iterator begin() noexcept {
         return iterator{data_.GetAddress()};
     }
 
     // Возвращает итератор на элемент, следующий за последним
-    iterator end() noexcept {
+    constexpr iterator end() noexcept {
         return iterator{data_.GetAddress()+size_};
     }
 
     // Возвращает константный итератор на начало вектора
-    const_iterator begin() const noexcept {
+    constexpr const_iterator begin() const noexcept {
         return const_iterator{data_.GetAddress()};
     }
 
     // Возвращает итератор на элемент, следующий за последним
-    const_iterator end() const noexcept {
+    constexpr const_iterator end() const noexcept {
         return const_iterator{data_.GetAddress()+size_};
     }
 
     // Возвращает константный итератор на начало вектора
-    const_iterator cbegin() const noexcept {
+    constexpr const_iterator cbegin() const noexcept {
         return begin();
     }
 
     // Возвращает итератор на элемент, следующий за последним
-    const_iterator cend() const noexcept {
+    constexpr const_iterator cend() const noexcept {
         return end();
     }
 
     // Обменивает значение с другим вектором
-    void Swap(Vector& other) noexcept {
+    constexpr void Swap(Vector& other) noexcept {
         data_.Swap(other.data_);
         std::swap(size_, other.size_);
     }
 
     // Возвращает количество элементов в векторе
-    size_t Size() const noexcept {
+    constexpr size_t Size() const noexcept {
         return size_;
     }
 
     // Возвращает вместимость вектора
-    size_t Capacity() const noexcept {
+    constexpr size_t Capacity() const noexcept {
         return data_.Capacity();
     }
 
     // Сообщает, пустой ли вектор
-    bool IsEmpty() const noexcept {
+    constexpr bool IsEmpty() const noexcept {
         return (0 == size_);
     }
 
     // Резервирует место
-    void Reserve(size_t new_capacity) {
+    constexpr void Reserve(size_t new_capacity) {
         if (new_capacity <= data_.Capacity()) {
             return;
         }
-        RawMemory<T> new_data(new_capacity);
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        RecordAllocation(new_capacity);
+        RecordRelocation(size_);
+        RelocateN(begin(), size_, new_data.GetAddress());
+        data_.Swap(new_data);
+    }
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> ||
-                     !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(begin(), size_, new_data.GetAddress());
-        }
-        else {
-            std::uninitialized_copy_n(begin(), size_, new_data.GetAddress());
+    // Уменьшает вместимость до текущего размера, возвращая
+    // излишек памяти аллокатору
+    constexpr void ShrinkToFit() {
+        if (size_ == Capacity()) {
+            return;
         }
-        std::destroy_n(begin(), size_);
+        RawMemory<T, Alloc> new_data(size_, data_.GetAllocator());
+        RecordAllocation(size_);
+        RecordRelocation(size_);
+        RelocateN(begin(), size_, new_data.GetAddress());
         data_.Swap(new_data);
     }
 
     // Возвращает ссылку на элемент с индексом index
-    T& operator[](size_t index) noexcept {
-        assert(index < size_);
+    constexpr T& operator[](size_t index) noexcept {
+        ADVANCED_VECTOR_VERIFY(index < size_);
         return data_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
-    const T& operator[](size_t index) const noexcept {
+    constexpr const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
+    // Возвращает указатель на непрерывный массив данных вектора
+    constexpr T* Data() noexcept {
+        return data_.GetAddress();
+    }
+
+    constexpr const T* Data() const noexcept {
+        return data_.GetAddress();
+    }
+
+    // Представляет содержимое вектора как std::span —
+    // потребителям не нужно пересобирать указатели из итераторов
+    constexpr std::span<T> AsSpan() noexcept {
+        return {Data(), size_};
+    }
+
+    constexpr std::span<const T> AsSpan() const noexcept {
+        return {Data(), size_};
+    }
+
+    constexpr std::span<const T> AsConstSpan() const noexcept {
+        return {Data(), size_};
+    }
+
+    // Возвращает указатель на данные с обещанием компилятору, что он
+    // выровнен по N байт — SIMD-потребители получают выровненные
+    // загрузки без reinterpret_cast. За фактическое выравнивание
+    // отвечает вызывающий (например, через AlignedAllocator)
+    template <size_t N>
+    T* AssumeAligned() noexcept {
+        return std::assume_aligned<N>(Data());
+    }
+
+    template <size_t N>
+    const T* AssumeAligned() const noexcept {
+        return std::assume_aligned<N>(Data());
+    }
+
+    // Линейный проход по вектору блоками по block_size элементов:
+    // fn(указатель, длина) вызывается для каждого блока, а кэш-линии
+    // следующего блока предвыбираются программно, пока обрабатывается
+    // текущий — DRAM-резидентные сканы не ждут аппаратный префетчер
+    template <typename Fn>
+    void ForEachBlock(size_t block_size, Fn fn) const {
+        ADVANCED_VECTOR_VERIFY(block_size > 0);
+        const T* data = Data();
+        for (size_t i = 0; i < size_; i += block_size) {
+            const size_t len = block_size < size_-i ? block_size : size_-i;
+            const size_t next = i+len;
+            PrefetchRange(data+next,
+                          block_size < size_-next ? block_size : size_-next);
+            fn(data+i, len);
+        }
+    }
+
+    // Проход fn(элемент) по всему вектору с блочной предвыборкой
+    template <typename Fn>
+    void Scan(Fn fn) const {
+        const size_t block_size = SCAN_BLOCK_BYTES / sizeof(T);
+        ForEachBlock(block_size == 0 ? 1 : block_size, [&fn](const T* block, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(block[i]);
+            }
+        });
+    }
+
+    // Возвращает ссылку на элемент с проверкой диапазона,
+    // не зависящей от уровня ADVANCED_VECTOR_HARDENING
+    constexpr T& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Vector::At: индекс вне диапазона");
+        }
+        return data_[index];
+    }
+
+    constexpr const T& At(size_t index) const {
+        return const_cast<Vector&>(*this).At(index);
+    }
+
     // Деструктор
-    ~Vector() {
-        std::destroy_n(begin(), size_);
+    constexpr ~Vector() {
+        DestroyN(begin(), size_);
+    }
+
+    // Очищает вектор, не изменяя вместимость. Для тривиально
+    // разрушаемых типов сводится к обнулению размера
+    constexpr void Clear() noexcept {
+        DestroyN(begin(), size_);
+        size_ = 0;
     }
 
     // Изменяет размер вектора
-    void Resize(size_t new_size) {
+    constexpr void Resize(size_t new_size) {
         if (new_size < size_) {
-            std::destroy_n(begin()+new_size, size_-new_size);
+            DestroyN(begin()+new_size, size_-new_size);
             size_ = new_size;
         }
         else {
             Reserve(new_size);
-            std::uninitialized_value_construct_n(end(), new_size-size_);
+            ValueConstructN(end(), new_size-size_);
             size_ = new_size;
         }
     }
 
+    // Изменяет размер вектора, не инициализируя новые элементы.
+    // Память под них резервируется, но байты остаются нетронутыми —
+    // вызывающий код обязан перезаписать их (например, через read).
+    // Доступно только для тривиальных типов, которым не нужны
+    // ни конструкторы, ни деструкторы
+    template <typename U = T>
+    constexpr std::enable_if_t<std::is_trivially_default_constructible_v<U> &&
+                     std::is_trivially_destructible_v<U>>
+    ResizeForOverwrite(size_t new_size) {
+        static_assert(std::is_same_v<U, T>);
+        Reserve(new_size);
+        size_ = new_size;
+    }
+
+    // Низкоуровневая операция: объявляет первые new_size элементов
+    // вектора сконструированными. Для кода, который строит элементы
+    // напрямую в зарезервированной памяти (см. ConcurrentAppender)
+    constexpr void SetSizeUnchecked(size_t new_size) noexcept {
+        ADVANCED_VECTOR_VERIFY(new_size <= Capacity());
+        size_ = new_size;
+    }
+
+    // Отдаёт хранилище вектора для повторного использования:
+    // элементы разрушаются, буфер уходит к вызывающему с сохранённой
+    // вместимостью, вектор остаётся пустым без памяти
+    constexpr RawMemory<T, Alloc> ReleaseStorage() noexcept {
+        DestroyN(begin(), size_);
+        size_ = 0;
+        return std::move(data_);
+    }
+
+    // Сохраняет снимок вектора в двоичный поток: небольшой заголовок
+    // и сырое содержимое буфера одной записью. Доступно только для
+    // тривиально копируемых типов — их представление на диске
+    // совпадает с представлением в памяти
+    void SaveTo(std::ostream& out) const {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Снимок доступен только для тривиально копируемых типов");
+        VectorSnapshotHeader header{VECTOR_SNAPSHOT_MAGIC, sizeof(T), alignof(T), size_};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(Data()),
+                  static_cast<std::streamsize>(size_ * sizeof(T)));
+        if (!out) {
+            throw std::runtime_error("Vector::SaveTo: ошибка записи снимка");
+        }
+    }
+
+    // Загружает снимок, записанный SaveTo: проверяет заголовок,
+    // выделяет буфер точно под размер и читает содержимое одним read.
+    // Прежнее содержимое вектора замещается
+    void LoadFrom(std::istream& in) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Снимок доступен только для тривиально копируемых типов");
+        VectorSnapshotHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in || header.magic != VECTOR_SNAPSHOT_MAGIC) {
+            throw std::runtime_error("Vector::LoadFrom: это не снимок вектора");
+        }
+        if (header.element_size != sizeof(T) || header.element_align != alignof(T)) {
+            throw std::runtime_error("Vector::LoadFrom: несовместимая раскладка элемента");
+        }
+        const size_t count = static_cast<size_t>(header.size);
+        RawMemory<T, Alloc> new_data(count, data_.GetAllocator());
+        in.read(reinterpret_cast<char*>(new_data.GetAddress()),
+                static_cast<std::streamsize>(count * sizeof(T)));
+        if (!in) {
+            throw std::runtime_error("Vector::LoadFrom: снимок обрывается");
+        }
+        DestroyN(begin(), size_);
+        data_.Swap(new_data);
+        size_ = count;
+        RecordAllocation(count);
+    }
+
+    // Принимает во владение внешний буфер из capacity элементов,
+    // первые size из которых уже сконструированы. Прежнее содержимое
+    // вектора разрушается. Буфер будет освобождён вызовом deleter,
+    // что позволяет оборачивать DMA/recv-буферы без копирования
+    constexpr void AdoptBuffer(T* ptr, size_t size, size_t capacity,
+                               typename RawMemory<T, Alloc>::Deleter deleter) {
+        ADVANCED_VECTOR_VERIFY(ptr != nullptr && size <= capacity);
+        DestroyN(begin(), size_);
+        data_ = RawMemory<T, Alloc>(ptr, capacity, deleter, data_.GetAllocator());
+        size_ = size;
+    }
+
+    // Отдаёт буфер вектора вызывающему коду без копирования,
+    // оставляя вектор пустым
+    constexpr ReleasedBuffer<T> ReleaseBuffer() noexcept {
+        ReleasedBuffer<T> released{data_.GetAddress(), size_,
+                                   data_.Capacity(), data_.GetDeleter()};
+        data_.Detach();
+        size_ = 0;
+        return released;
+    }
+
+    // Изменяет размер вектора, распределяя конструирование либо
+    // разрушение элементов по num_threads потокам. Выгодно на
+    // многомиллионных векторах, где однопоточная инициализация
+    // упирается в одно ядро
+    void ResizeParallel(size_t new_size, size_t num_threads) {
+        const size_t delta = new_size < size_ ? size_-new_size : new_size-size_;
+        if (num_threads <= 1 || delta < MIN_PARALLEL_CHUNK) {
+            Resize(new_size);
+            return;
+        }
+        if (new_size < size_) {
+            T* from = begin()+new_size;
+            ForEachChunk(from, size_-new_size, num_threads, [](T* chunk, size_t count) noexcept {
+                DestroyN(chunk, count);
+            });
+            size_ = new_size;
+        }
+        else {
+            Reserve(new_size);
+            ParallelConstruct(end(), new_size-size_, num_threads);
+            size_ = new_size;
+        }
+    }
+
+    // Очищает вектор, разрушая элементы в num_threads потоков
+    void ClearParallel(size_t num_threads) noexcept {
+        if (num_threads <= 1 || size_ < MIN_PARALLEL_CHUNK) {
+            Clear();
+            return;
+        }
+        ForEachChunk(begin(), size_, num_threads, [](T* chunk, size_t count) noexcept {
+            DestroyN(chunk, count);
+        });
+        size_ = 0;
+    }
+
+    // Добавляет элементы диапазона [first, last) в конец вектора.
+    // Итоговый размер вычисляется заранее, поэтому вместимость
+    // увеличивается не более одного раза
+    template <typename InputIt>
+    constexpr void AppendRange(InputIt first, InputIt last) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return;
+        }
+        if (size_+count > Capacity()) {
+            Reserve(NextCapacity(size_+count));
+        }
+        CopyConstruct(first, last, end());
+        size_ += count;
+    }
+
+    // Заменяет содержимое вектора элементами диапазона [first, last),
+    // переиспользуя уже выделенную память, когда её достаточно
+    template <typename InputIt>
+    constexpr void Assign(InputIt first, InputIt last) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count > Capacity()) {
+            RawMemory<T, Alloc> new_data(count, data_.GetAllocator());
+            RecordAllocation(count);
+            CopyConstruct(first, last, new_data.GetAddress());
+            DestroyN(begin(), size_);
+            data_.Swap(new_data);
+        }
+        else {
+            const size_t common = count < size_ ? count : size_;
+            InputIt mid = std::next(first, common);
+            std::copy(first, mid, begin());
+            if (count < size_) {
+                DestroyN(begin()+count, size_-count);
+            }
+            else {
+                CopyConstruct(mid, last, end());
+            }
+        }
+        size_ = count;
+    }
+
     // Добавляет элемент в конец вектора
-    void PushBack(const T& value) {
+    constexpr void PushBack(const T& value) {
         EmplaceBack(std::forward<const T&>(value));
     }
 
     // Перемещает элемент в конец вектора
-    void PushBack(T&& value) {
+    constexpr void PushBack(T&& value) {
         EmplaceBack(std::forward<T&&>(value));
     }
 
     // Перемещает значения args в конец вектора
     // Возвращает значение
     template<typename... Args>
-    T& EmplaceBack(Args&&... args) {
+    constexpr T& EmplaceBack(Args&&... args) {
         T* entry = nullptr;
         if (size_ == Capacity()) {
-            RawMemory<T> new_data(IsEmpty() ? 1 : size_ * 2);
-            entry = new (new_data+size_) T(std::forward<Args>(args)...);
-            if constexpr (std::is_nothrow_move_constructible_v<T> ||
-                         !std::is_copy_constructible_v<T>) {
-                std::uninitialized_move_n(begin(), size_, new_data.GetAddress());
-            }
-            else {
-                std::uninitialized_copy_n(begin(), size_, new_data.GetAddress());
-            }
-            std::destroy_n(begin(), size_);
+            RawMemory<T, Alloc> new_data(NextCapacity(size_+1), data_.GetAllocator());
+            RecordAllocation(new_data.Capacity());
+            RecordRelocation(size_);
+            entry = std::construct_at(new_data+size_, std::forward<Args>(args)...);
+            RelocateN(begin(), size_, new_data.GetAddress());
             data_.Swap(new_data);
         }
         else {
-            entry = new (data_+size_) T(std::forward<Args>(args)...);
+            entry = std::construct_at(data_+size_, std::forward<Args>(args)...);
         }
         ++size_;
         return *entry;
     }
 
     // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
-    void PopBack() noexcept {
+    constexpr void PopBack() noexcept {
         if (size_ > 0) {
-            std::destroy_at(end()-1);
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::destroy_at(end()-1);
+            }
             --size_;
         }
     }
@@ -297,74 +844,338 @@ public:
     // Перемещает значения args в позицию pos
     // Возвращает итератор
     template<typename... Args>
-    iterator Emplace(const_iterator pos, Args&&... args) {
-        assert(pos >= begin() && pos <= end());
+    constexpr iterator Emplace(const_iterator pos, Args&&... args) {
+        ADVANCED_VECTOR_VERIFY(pos >= begin() && pos <= end());
         size_t shift = pos-begin();
         iterator result = nullptr;
         if (size_ == Capacity()) {
-            RawMemory<T> new_data(IsEmpty() ? 1 : size_ * 2);
-            result = new (new_data+shift) T(std::forward<Args>(args)...);
-            if constexpr (std::is_nothrow_move_constructible_v<T> ||
-                         !std::is_copy_constructible_v<T>) {
-                std::uninitialized_move_n(begin(),
-                                          shift,
-                                          new_data.GetAddress());
-
-                std::uninitialized_move_n(begin()+shift,
-                                          size_-shift,
-                                          new_data.GetAddress()+shift+1);
-            }
-            else {
-                std::uninitialized_copy_n(begin(),
-                                          shift,
-                                          new_data.GetAddress());
-
-                std::uninitialized_copy_n(begin()+shift,
-                                          size_-shift,
-                                          new_data.GetAddress()+shift+1);
-            }
-            std::destroy_n(begin(), size_);
+            RawMemory<T, Alloc> new_data(NextCapacity(size_+1), data_.GetAllocator());
+            RecordAllocation(new_data.Capacity());
+            RecordRelocation(size_);
+            result = std::construct_at(new_data+shift, std::forward<Args>(args)...);
+            RelocateN(begin(), shift, new_data.GetAddress());
+            RelocateN(begin()+shift, size_-shift, new_data.GetAddress()+shift+1);
             data_.Swap(new_data);
         }
         else {
-            if (size_ != 0) {
-                if constexpr (std::is_nothrow_move_constructible_v<T> ||
-                             !std::is_copy_constructible_v<T>) {
-                    new (data_+size_) T(std::move(*(end()-1)));
-                    std::move_backward(begin()+shift, end(), end()+1);
+            const auto emplace_generic = [&] {
+                if (size_ != 0 && shift != size_) {
+                    // Последний элемент переезжает в сырую память,
+                    // остальная часть хвоста сдвигается присваиванием —
+                    // ровно по одному переносу на элемент
+                    std::construct_at(data_+size_, std::move(*(end()-1)));
+                    std::move_backward(begin()+shift, end()-1, end());
+                    std::destroy_at(begin()+shift);
+                }
+                result = std::construct_at(data_+shift, std::forward<Args>(args)...);
+            };
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (!std::is_constant_evaluated()) {
+                    // Аргументы могут ссылаться на элементы самого вектора,
+                    // поэтому значение материализуется до сдвига хвоста
+                    T tmp(std::forward<Args>(args)...);
+                    std::memmove(begin()+shift+1, begin()+shift, (size_-shift) * sizeof(T));
+                    result = std::construct_at(data_+shift, std::move(tmp));
                 }
                 else {
-                    new (data_+size_) T(std::move(*(end()-1)));
-                    std::move_backward(begin()+shift, end(), end()+1);
+                    emplace_generic();
                 }
-                std::destroy_at(begin()+shift);
             }
-            result = new (data_+shift) T(std::forward<Args>(args)...);
+            else {
+                emplace_generic();
+            }
         }
         ++size_;
         return result;
     }
 
     // Удаляет элемент вектора в указанной позиции
-    iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
-        assert(pos >= begin() && pos < end());
+    constexpr iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        ADVANCED_VECTOR_VERIFY(pos >= begin() && pos < end());
         size_t index = pos-begin();
-        std::move(begin()+index+1, end(), begin()+index);
+        const auto erase_generic = [&] {
+            std::move(begin()+index+1, end(), begin()+index);
+            PopBack();
+        };
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                // Деструктор тривиален, хвост сдвигается одним memmove
+                std::memmove(begin()+index, begin()+index+1, (size_-index-1) * sizeof(T));
+                --size_;
+            }
+            else {
+                erase_generic();
+            }
+        }
+        else {
+            erase_generic();
+        }
+        return begin()+index;
+    }
+
+    // Удаляет элемент в позиции pos за O(1), перемещая на его место
+    // последний элемент вектора. Порядок элементов не сохраняется
+    constexpr iterator SwapRemove(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        ADVANCED_VECTOR_VERIFY(pos >= begin() && pos < end());
+        size_t index = pos-begin();
+        if (index+1 != size_) {
+            data_[index] = std::move(data_[size_-1]);
+        }
         PopBack();
         return begin()+index;
     }
 
+    // Удаляет элементы диапазона [first, last),
+    // сдвигая хвост одним проходом
+    constexpr iterator Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        ADVANCED_VECTOR_VERIFY(first >= begin() && first <= last && last <= end());
+        size_t index = first-begin();
+        size_t count = last-first;
+        if (count != 0) {
+            const auto erase_generic = [&] {
+                std::move(begin()+index+count, end(), begin()+index);
+                DestroyN(end()-count, count);
+            };
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (!std::is_constant_evaluated()) {
+                    std::memmove(begin()+index, begin()+index+count,
+                                 (size_-index-count) * sizeof(T));
+                }
+                else {
+                    erase_generic();
+                }
+            }
+            else {
+                erase_generic();
+            }
+            size_ -= count;
+        }
+        return begin()+index;
+    }
+
+    // Удаляет все элементы, удовлетворяющие предикату pred,
+    // уплотняя вектор за один проход.
+    // Возвращает количество удалённых элементов
+    template <typename Pred>
+    constexpr size_t EraseIf(Pred pred) {
+        iterator new_end = std::remove_if(begin(), end(), pred);
+        const size_t removed = end()-new_end;
+        DestroyN(new_end, removed);
+        size_ -= removed;
+        return removed;
+    }
+
     // Вставляет значение value в позицию pos
-    iterator Insert(const_iterator pos, const T& value) {
+    constexpr iterator Insert(const_iterator pos, const T& value) {
         return Emplace(pos, value);
     }
 
     // Перемещает значение value в позицию pos
-    iterator Insert(const_iterator pos, T&& value) {
+    constexpr iterator Insert(const_iterator pos, T&& value) {
         return Emplace(pos, std::move(value));
     }
 
+    // Вставляет элементы диапазона [first, last) перед позицией pos.
+    // Вместимость увеличивается не более одного раза, хвост сдвигается
+    // одним проходом. Диапазон не должен ссылаться на сам вектор
+    template <typename InputIt>
+    constexpr iterator Insert(const_iterator pos, InputIt first, InputIt last) {
+        ADVANCED_VECTOR_VERIFY(pos >= begin() && pos <= end());
+        const size_t shift = pos-begin();
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return begin()+shift;
+        }
+        if (size_+count > Capacity()) {
+            RawMemory<T, Alloc> new_data(NextCapacity(size_+count), data_.GetAllocator());
+            RecordAllocation(new_data.Capacity());
+            RecordRelocation(size_);
+            CopyConstruct(first, last, new_data.GetAddress()+shift);
+            RelocateN(begin(), shift, new_data.GetAddress());
+            RelocateN(begin()+shift, size_-shift, new_data.GetAddress()+shift+count);
+            data_.Swap(new_data);
+        }
+        else {
+            const auto insert_generic = [&] {
+                const size_t tail = size_-shift;
+                if (count >= tail) {
+                    // Весь хвост переезжает в сырую память за новыми элементами
+                    UninitializedMove(begin()+shift, end(), begin()+shift+count);
+                    InputIt mid = std::next(first, tail);
+                    std::copy(first, mid, begin()+shift);
+                    CopyConstruct(mid, last, end());
+                }
+                else {
+                    // Часть хвоста конструируется в сырой памяти,
+                    // остальное сдвигается присваиванием
+                    UninitializedMove(end()-count, end(), end());
+                    std::move_backward(begin()+shift, end()-count, end());
+                    std::copy(first, last, begin()+shift);
+                }
+            };
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (!std::is_constant_evaluated()) {
+                    std::memmove(begin()+shift+count, begin()+shift, (size_-shift) * sizeof(T));
+                    std::uninitialized_copy(first, last, begin()+shift);
+                }
+                else {
+                    insert_generic();
+                }
+            }
+            else {
+                insert_generic();
+            }
+        }
+        size_ += count;
+        return begin()+shift;
+    }
+
+    // Возвращает используемый аллокатор
+    constexpr const Alloc& GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+#ifdef ADVANCED_VECTOR_STATS
+    // Возвращает счётчики памяти этого вектора
+    const VectorStats& Stats() const noexcept {
+        return stats_;
+    }
+#endif
+
 private:
-    RawMemory<T> data_;
+    // Учитывает выделение памяти под elements элементов.
+    // Без ADVANCED_VECTOR_STATS сводится к пустому телу
+    constexpr void RecordAllocation([[maybe_unused]] size_t elements) noexcept {
+#ifdef ADVANCED_VECTOR_STATS
+        ++stats_.allocations;
+        stats_.bytes_requested += elements * sizeof(T);
+        if (elements > stats_.peak_capacity) {
+            stats_.peak_capacity = elements;
+        }
+        if (!std::is_constant_evaluated() && g_vector_stats_callback != nullptr) {
+            g_vector_stats_callback(stats_);
+        }
+#endif
+    }
+
+    // Учитывает переезд count элементов в новую память
+    constexpr void RecordRelocation([[maybe_unused]] size_t count) noexcept {
+#ifdef ADVANCED_VECTOR_STATS
+        // Первое выделение пустого вектора переездом не считается
+        if (count == 0) {
+            return;
+        }
+        ++stats_.reallocations;
+        if constexpr (IsTriviallyRelocatable<T>::value ||
+                      std::is_nothrow_move_constructible_v<T> ||
+                      AssumeNothrowMove<T>::value ||
+                     !std::is_copy_constructible_v<T>) {
+            stats_.elements_moved += count;
+        }
+        else {
+            stats_.elements_copied += count;
+        }
+#endif
+    }
+
+    // Минимальный объём работы, оправдывающий запуск потоков
+    static constexpr size_t MIN_PARALLEL_CHUNK = 64 * 1024;
+
+    // Размер блока сканирования по умолчанию
+    static constexpr size_t SCAN_BLOCK_BYTES = 4096;
+
+    // Делит диапазон из count элементов на num_threads сплошных кусков
+    // и выполняет fn(начало, длина) над каждым в собственном потоке
+    template <typename Fn>
+    static void ForEachChunk(T* from, size_t count, size_t num_threads, Fn fn) {
+        const size_t chunk = count / num_threads;
+        Vector<std::thread> workers;
+        workers.Reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            T* chunk_begin = from+i * chunk;
+            const size_t chunk_size = (i+1 == num_threads) ? count-i * chunk : chunk;
+            workers.EmplaceBack(fn, chunk_begin, chunk_size);
+        }
+        for (size_t i = 0; i < workers.Size(); ++i) {
+            workers[i].join();
+        }
+    }
+
+    // Параллельно конструирует count элементов по умолчанию начиная
+    // с from. При исключении в любом потоке уже построенные куски
+    // разрушаются, и первое исключение пробрасывается дальше
+    static void ParallelConstruct(T* from, size_t count, size_t num_threads) {
+        Vector<std::exception_ptr> errors(num_threads);
+        const size_t chunk = count / num_threads;
+        {
+            Vector<std::thread> workers;
+            workers.Reserve(num_threads);
+            for (size_t i = 0; i < num_threads; ++i) {
+                T* chunk_begin = from+i * chunk;
+                const size_t chunk_size = (i+1 == num_threads) ? count-i * chunk : chunk;
+                workers.EmplaceBack([chunk_begin, chunk_size, &error = errors[i]] {
+                    try {
+                        std::uninitialized_value_construct_n(chunk_begin, chunk_size);
+                    } catch (...) {
+                        // Частично построенный кусок разрушил сам алгоритм
+                        error = std::current_exception();
+                    }
+                });
+            }
+            for (size_t i = 0; i < workers.Size(); ++i) {
+                workers[i].join();
+            }
+        }
+        std::exception_ptr first_error = nullptr;
+        for (size_t i = 0; i < num_threads; ++i) {
+            if (errors[i] != nullptr && first_error == nullptr) {
+                first_error = errors[i];
+            }
+        }
+        if (first_error != nullptr) {
+            for (size_t i = 0; i < num_threads; ++i) {
+                if (errors[i] == nullptr) {
+                    T* chunk_begin = from+i * chunk;
+                    const size_t chunk_size = (i+1 == num_threads) ? count-i * chunk : chunk;
+                    DestroyN(chunk_begin, chunk_size);
+                }
+            }
+            std::rethrow_exception(first_error);
+        }
+    }
+
+    // Вычисляет вместимость при росте до требуемого размера required,
+    // сохраняя геометрическую прогрессию выбранной политики
+    constexpr size_t NextCapacity(size_t required) const {
+        const size_t grown = Growth::Next(Capacity(), sizeof(T));
+        return grown < required ? required : grown;
+    }
+
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
+#ifdef ADVANCED_VECTOR_STATS
+    VectorStats stats_;
+#endif
 };
+
+// Проход по двум векторам в ногу: fn(элемент lhs, элемент rhs)
+// вызывается для каждой пары индексов до конца более короткого
+// вектора, блоки обоих векторов предвыбираются одновременно —
+// для строковых join-ов по нескольким массивам
+template <typename T, typename U, typename AT, typename GT, typename AU, typename GU, typename Fn>
+void ScanZip(const Vector<T, AT, GT>& lhs, const Vector<U, AU, GU>& rhs,
+             size_t block_size, Fn fn) {
+    const size_t count = lhs.Size() < rhs.Size() ? lhs.Size() : rhs.Size();
+    const T* left = lhs.Data();
+    const U* right = rhs.Data();
+    for (size_t i = 0; i < count; i += block_size) {
+        const size_t len = block_size < count-i ? block_size : count-i;
+        const size_t next = i+len;
+        const size_t next_len = block_size < count-next ? block_size : count-next;
+        PrefetchRange(left+next, next_len);
+        PrefetchRange(right+next, next_len);
+        for (size_t j = i; j < next; ++j) {
+            fn(left[j], right[j]);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "vector.h"
+
+// Пул тёплых буферов для короткоживущих векторов: вместо того чтобы
+// освобождать память в деструкторе и тут же выделять её заново под
+// следующее сообщение, вектор возвращает хранилище в пул через
+// Release, а Acquire выдаёт его следующему потребителю с уже
+// выделенной вместимостью
+template <typename T, typename Alloc = std::allocator<T>>
+class VectorPool {
+public:
+    explicit VectorPool(size_t max_pooled = 64) noexcept
+        : max_pooled_(max_pooled) {
+    }
+
+    // Возвращает пустой вектор, по возможности поверх тёплого буфера
+    Vector<T, Alloc> Acquire() {
+        if (!buffers_.IsEmpty()) {
+            RawMemory<T, Alloc> storage = std::move(buffers_[buffers_.Size()-1]);
+            buffers_.PopBack();
+            return Vector<T, Alloc>(std::move(storage));
+        }
+        return Vector<T, Alloc>{};
+    }
+
+    // Забирает хранилище вектора в пул. Сверх лимита max_pooled
+    // буферы просто освобождаются
+    void Release(Vector<T, Alloc>&& vector) {
+        if (vector.Capacity() != 0 && buffers_.Size() < max_pooled_) {
+            buffers_.EmplaceBack(vector.ReleaseStorage());
+        }
+    }
+
+    // Возвращает количество буферов, ожидающих в пуле
+    size_t PooledCount() const noexcept {
+        return buffers_.Size();
+    }
+
+    // Освобождает все накопленные буферы
+    void Trim() noexcept {
+        buffers_.Clear();
+        buffers_.ShrinkToFit();
+    }
+
+private:
+    Vector<RawMemory<T, Alloc>> buffers_;
+    size_t max_pooled_;
+};
+
+// Возвращает пул векторов текущего потока — обращение к нему
+// не требует синхронизации
+template <typename T, typename Alloc = std::allocator<T>>
+VectorPool<T, Alloc>& ThreadLocalVectorPool() {
+    static thread_local VectorPool<T, Alloc> pool;
+    return pool;
+}